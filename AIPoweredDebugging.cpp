@@ -52,7 +52,9 @@ int main() {
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <string>
 #include <asmjit/asmjit.h>
+#include "runtime/vault_pool.hpp"
 
 using namespace asmjit;
 
@@ -72,8 +74,16 @@ public:
         std::cout << "[ASM] ✅ CPU Register Execution Debugging Enabled" << std::endl;
     }
 
-    void monitorMemory() {
+    // Per-class occupancy straight from the vault pool's counters
+    void monitorMemory(MicroFixVaultPool& pool) {
         std::cout << "[ASM] 🔍 Monitoring Memory Allocation Hooks..." << std::endl;
+        pool.flushThreadCache();
+        for (const auto& stats : pool.statistics()) {
+            if (stats.allocations == 0) continue;
+            std::cout << "[ASM] 📦 Class " << (stats.objectBytes ? std::to_string(stats.objectBytes) + "B" : std::string("large"))
+                      << ": " << stats.live << " live (peak " << stats.peakLive << "), "
+                      << static_cast<int>(stats.occupancy() * 100) << "% of " << stats.capacity << " slots" << std::endl;
+        }
     }
 
     void optimizeThreadExecution() {
@@ -83,8 +93,13 @@ public:
 
 int main() {
     MicroFixDebugger debugger;
+    MicroFixVaultPool pool;
+    std::vector<void*> records;
+    for (size_t i = 0; i < 1000; ++i) records.push_back(pool.allocate(48 + (i % 4) * 64));
+    for (size_t i = 0; i < records.size(); i += 2) pool.deallocate(records[i], 48 + (i % 4) * 64);
+
     debugger.analyzeRegisters();
-    debugger.monitorMemory();
+    debugger.monitorMemory(pool);
     debugger.optimizeThreadExecution();
 
     return 0;
@@ -92,23 +107,18 @@ int main() {
 
 #include <iostream>
 #include <vector>
-#include <asmjit/asmjit.h>
-
-using namespace asmjit;
+#include "runtime/vault_pool.hpp"
 
 // Memory visualization & real-time ASM directive transformation
 class MicroFixMemoryAnalyzer {
 public:
-    void traceMemoryVault() {
-        JitRuntime rt;
-        CodeHolder code;
-        code.init(rt.environment());
-
-        x86::Assembler assembler(&code);
-        assembler.mov(x86::rax, 0xDEADBEEF);  // Example memory vault tracking
-        assembler.mov(x86::rbx, 0xFEEDC0DE);
-        assembler.ret();
-
+    // Reports where vault records come from, using the pool's sampled allocation sites
+    void traceMemoryVault(MicroFixVaultPool& pool) {
+        auto sites = pool.sampledSites();
+        for (size_t i = 0; i < sites.size() && i < 5; ++i) {
+            std::cout << "[ASM] 📍 " << sites[i].function << " (" << sites[i].file << ":" << sites[i].line << ") ~"
+                      << sites[i].estimatedBytes << " bytes over " << sites[i].samples << " samples" << std::endl;
+        }
         std::cout << "[ASM] ✅ Memory Vault Allocation Traced Successfully" << std::endl;
     }
 
@@ -123,7 +133,12 @@ public:
 
 int main() {
     MicroFixMemoryAnalyzer memoryAnalyzer;
-    memoryAnalyzer.traceMemoryVault();
+    MicroFixVaultPool pool(false, 16);
+    std::vector<void*> records;
+    for (size_t i = 0; i < 4096; ++i) records.push_back(pool.allocate(i % 8 ? 64 : 512));
+    for (size_t i = 0; i < records.size(); ++i) pool.deallocate(records[i], i % 8 ? 64 : 512);
+
+    memoryAnalyzer.traceMemoryVault(pool);
     memoryAnalyzer.mapDirectiveTransformations();
     memoryAnalyzer.optimizeGuildProcessing();
 
@@ -611,6 +626,9 @@ int main() {
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include "runtime/exec_policy.hpp"
 
 // AI-driven uninterrupted execution enforcement system
 class MicroFixExecutionManager {
@@ -619,14 +637,39 @@ public:
     std::vector<std::string> directivePaths;
     bool executionStable = true;
 
+    // Directives run under per-kind retry/backoff and circuit-breaker policies instead of
+    // being tagged as bypassed; anything that still fails comes back through the failure queue
     void enforceExecutionContinuity() {
         std::cout << "[MicroFixAI] 🔍 Enforcing Uninterrupted Execution..." << std::endl;
-        for (auto& directive : directivePaths) {
-            if (directive.find("runtime_error") != std::string::npos) {
-                directive += " [Error Bypassed - Execution Continues]";
-                executionStable = true;  // Ensure flawless execution without stops
+        MicroFixEventLoop timers;
+        MicroFixExecutionPolicy policy(timers);
+        MicroFixRetryPolicy flapping;
+        flapping.baseDelay = std::chrono::milliseconds(5);
+        uint32_t standardKind = policy.defineKind("Standard");
+        uint32_t dependencyKind = policy.defineKind("Downstream Dependency", flapping);
+
+        std::vector<unsigned> attempts(directivePaths.size(), 0);
+        for (size_t i = 0; i < directivePaths.size(); ++i) {
+            bool dependent = directivePaths[i].find("runtime_error") != std::string::npos;
+            policy.execute(dependent ? dependencyKind : standardKind, directivePaths[i], [&, i, dependent] {
+                // Simulated flapping dependency: the first two attempts fail
+                if (++attempts[i] <= 2 && dependent) throw std::runtime_error("dependency unavailable");
+                executionLog.push_back(directivePaths[i]);
+            });
+        }
+        timers.runUntilIdle();  // Backoff timers fire the retries
+
+        std::vector<std::string> failed;
+        policy.drainFailures([&](MicroFixFailedDirective failure) {
+            std::cout << "❌ " << failure.directive << " failed after " << failure.attempts << " attempt(s): " << failure.reason << std::endl;
+            failed.push_back(failure.directive);
+        });
+        for (size_t i = 0; i < directivePaths.size(); ++i) {
+            if (attempts[i] > 1 && std::find(failed.begin(), failed.end(), directivePaths[i]) == failed.end()) {
+                directivePaths[i] += " [Recovered after " + std::to_string(attempts[i] - 1) + " retries]";
             }
         }
+        executionStable = failed.empty();
     }
 
     void optimizeDirectiveFusion() {
@@ -660,22 +703,38 @@ int main() {
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include "runtime/checkpoint.hpp"
 
 // AI-driven self-repairing execution system
 class MicroFixRecoveryManager {
 public:
     std::vector<std::string> directivePaths;
     std::vector<std::string> recoveredDirectives;
+    size_t directivesPerCheckpoint = 64;
 
+    // Runs the batch against checkpointed state: a fault rolls back to the last checkpoint and
+    // reruns only that range, retrying the failed directive in reconstructed form
     void diagnoseFailedDirectives() {
         std::cout << "[MicroFixAI] 🔍 Diagnosing Failed Executions..." << std::endl;
-        for (auto& directive : directivePaths) {
-            if (directive.find("execution_fault") != std::string::npos) {
-                recoveredDirectives.push_back(directive + " [Auto-Reconstructed]");
-            } else {
-                recoveredDirectives.push_back(directive);
+        enum : uint8_t { Pending, Completed, Reconstructed };
+        MicroFixCheckpointArena executionState(std::max<size_t>(1, directivePaths.size()));  // One status byte per directive
+        MicroFixCheckpointedRun run(executionState, directivesPerCheckpoint);
+        MicroFixRecoveryReport report = run.run(directivePaths.size(), [&](size_t index, unsigned attempt) {
+            if (directivePaths[index].find("execution_fault") != std::string::npos && attempt == 0) {
+                throw std::runtime_error("Directive " + std::to_string(index) + " faulted");
             }
+            executionState.at<uint8_t>(index) = attempt == 0 ? Completed : Reconstructed;
+        });
+
+        for (size_t index = 0; index < directivePaths.size(); ++index) {
+            uint8_t status = executionState.get<uint8_t>(index);
+            if (status == Completed) recoveredDirectives.push_back(directivePaths[index]);
+            if (status == Reconstructed) recoveredDirectives.push_back(directivePaths[index] + " [Auto-Reconstructed]");
         }
+        std::cout << "[MicroFixAI] ♻️ " << report.restarts << " restart(s) from checkpoint, " << report.rerun
+                  << " directive run(s) repeated, " << report.abandoned.size() << " abandoned" << std::endl;
     }
 
     void applyRecoveryLogic() {
@@ -1048,9 +1107,12 @@ int main() {
 #include <iostream>
 #include <vector>
 #include <thread>
-#include <mutex>
+#include "runtime/guild_executor.hpp"
+#include "runtime/guild_fusion.hpp"
+#include "runtime/guild_state.hpp"
+#include "runtime/guild_sync.hpp"
 
-std::mutex executionLock;  // Ensuring thread-safe directive execution
+MicroFixGuildSync guildSync;  // Versioned guild rules, read lock-free by every guild member
 
 class MicroFixGuildSystem {
 public:
@@ -1058,10 +1120,51 @@ public:
     bool fallback_threads = true;
     std::pair<int, int> proof_sync_range = {0xA, 0xF};
     std::string thread_logic = "parallel_stream";
+    MicroFixGuildStateVector guild_state_vector{guilds_attached.size(), proof_sync_range};
+
+    // guild_state_vector belongs to the guild loop; its timer ships pending proofs even once the guild goes quiet
+    void startGuildStateSync(MicroFixEventLoop& guildLoop) {
+        guild_state_vector.syncOnTimer(guildLoop, [](MicroFixGuildStateDelta delta) {
+            std::cout << "[MicroFix] 🔄 Guild State v" << delta.version << " synced (" << delta.entries << " entries, "
+                      << delta.wireBytes() << " bytes)" << std::endl;
+        });
+    }
+
+    // Records one guild proof on the guild loop; a delta ships once a proof_sync_range batch is due
+    void recordGuildState(MicroFixEventLoop& guildLoop, size_t guild, bool guild_state) {
+        guildLoop.post([this, guild, guild_state] { guild_state_vector.set(guild, guild_state ? 1 : 0); });
+    }
+
+    void publishGuildRules() {
+        guildSync.update([this](MicroFixGuildRuleSet& rules) {
+            rules.guilds = guilds_attached;
+            rules.rules["thread_logic"] = thread_logic;
+            rules.rules["on_false"] = "safe_mode,recovery.logic";
+            rules.rules["on_true"] = "stream.push,proof.buffer";
+        });
+    }
+
+    // Parallel GuildRule Fusion: merges every guild's proposals and publishes the result as one version
+    uint64_t fuseGuildRules(MicroFixGuildRuleFusion& fusion, const std::vector<MicroFixRuleSource>& sources) {
+        MicroFixFusionResult fused = fusion.fuse(sources);
+        for (const auto& conflict : fused.conflicts) {
+            std::cout << "⚠️ GuildRule Conflict on " << conflict.key << " (" << conflict.proposals.size()
+                      << " proposals) resolved to " << conflict.resolved.value_or("<dropped>") << std::endl;
+        }
+        return guildSync.publish(std::move(fused.rules));
+    }
+
+    // One pinned worker group per attached guild; fallback_threads backs sealed branches
+    std::vector<MicroFixGuildExecutor::BranchId> launchRuleBranches(MicroFixGuildExecutor& executor) {
+        std::vector<MicroFixGuildExecutor::BranchId> branches;
+        size_t workersPerBranch = thread_logic == "parallel_stream" ? 2 : 1;
+        for (const auto& guild : guilds_attached) branches.push_back(executor.addBranch(guild, workersPerBranch));
+        return branches;
+    }
 
     void processGuildDirective(bool guild_state) {
-        std::lock_guard<std::mutex> lock(executionLock);
-        std::cout << "[MicroFix] 🔍 Processing Guild Directive..." << std::endl;
+        MicroFixGuildSync::ReadGuard rules(guildSync);
+        std::cout << "[MicroFix] 🔍 Processing Guild Directive (GuildSync v" << rules->version << ")..." << std::endl;
 
         if (!guild_state) {
             std::cout << "⚠️ Guild State is FALSE. Enabling Safe Mode and Recovery Logic." << std::endl;
@@ -1088,9 +1191,26 @@ public:
 
 int main() {
     MicroFixGuildSystem guildSystem;
+    guildSystem.publishGuildRules();
     bool guild_state = false; // Simulating an unstable guild state
 
-    guildSystem.processGuildDirective(guild_state); // AI-driven guild execution & fault recovery
+    MicroFixEventLoop guildLoop;
+    guildSystem.startGuildStateSync(guildLoop);
+    guildSystem.recordGuildState(guildLoop, 0, true);  // Guild 0 starts out stable
+    guildLoop.runUntilIdle();
+    MicroFixGuildExecutor executor(guildSystem.fallback_threads ? 2 : 0);
+    auto branches = guildSystem.launchRuleBranches(executor);
+    executor.submit(branches[0], [&] {
+        guildSystem.recordGuildState(guildLoop, 0, guild_state);
+        guildSystem.processGuildDirective(guild_state); // AI-driven guild execution & fault recovery
+    });
+    executor.drain();
+    guildLoop.runUntilIdle();  // A single proof is below proof_sync_range; the window timer still ships the flip to false
+
+    for (const auto& branch : executor.report()) {
+        std::cout << "📌 Branch " << branch.name << ": " << branch.completed << " completed, "
+                  << branch.failed << " failed" << (branch.sealed ? " [Sealed]" : "") << std::endl;
+    }
 
     return 0;
 }
@@ -1099,12 +1219,35 @@ int main() {
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <memory>
+#include "runtime/descriptor_store.hpp"
+#include "runtime/event_registry.hpp"
+#include "runtime/scoped_toggle.hpp"
+#include "runtime/trigger_graph.hpp"
 
 // Mission directive processing system
 class MicroFixMissionLogic {
 public:
     bool readyStateConfirmed = false;
+    bool announceEvents = true;
     std::string missionOutcome = "Pending";
+    MicroFixEventTable events;
+    MicroFixTriggerGraph outcomes;
+    uint64_t reinforcementsCalled = 0;
+
+    explicit MicroFixMissionLogic(MicroFixWorkerPool* pool = nullptr) : outcomes(pool) {
+        events.bind("Overload", [this](const MicroFixEvent&) { callReinforcementPack(); });  // event Overload => call ReinforcementPack
+
+        // outcome "Success" triggers ProtocolLaunch
+        outcomes.addNode("Success");
+        outcomes.addNode("Fallback Sequence Executed");
+        outcomes.addNode("ProtocolLaunch", [] {
+            std::cout << "🚀 ProtocolLaunch Engaged" << std::endl;
+            return true;
+        });
+        outcomes.addTrigger("Success", "ProtocolLaunch");
+        outcomes.load();
+    }
 
     void executeMissionSequence() {
         std::cout << "[MicroFix] 🔄 Processing Mission Logic..." << std::endl;
@@ -1116,31 +1259,69 @@ public:
             std::this_thread::sleep_for(std::chrono::seconds(3));
             missionOutcome = "Fallback Sequence Executed";
         }
+        outcomes.fire(missionOutcome).wait();
     }
 
-    void handleEvent(std::string event) {
-        if (event == "Overload") {
-            std::cout << "⚠️ Overload Detected. Calling ReinforcementPack..." << std::endl;
+    // Name lookup for ad-hoc callers; fleets deliver interned ids through MicroFixEventFleet
+    void handleEvent(std::string_view event) {
+        if (!events.dispatch(event) && announceEvents) {
+            std::cout << "❔ No binding for event " << event << std::endl;
         }
     }
+
+    void callReinforcementPack() {
+        ++reinforcementsCalled;
+        if (announceEvents) std::cout << "⚠️ Overload Detected. Calling ReinforcementPack..." << std::endl;
+    }
 };
 
 // Stealth-based execution model
 class MicroFixCrimsonVeil {
 public:
     bool breachDetected = false;
-    bool memoryStateMutable = false;
+    MicroFixDescriptorStore agentMind{64 * 1024};  // descriptor AgentMind => Immutable
+    MicroFixTriggerGraph outcomes;
+
+    explicit MicroFixCrimsonVeil(MicroFixWorkerPool* pool = nullptr) : outcomes(pool) {
+        // outcome: BreachFacility triggers EchoGate
+        outcomes.addNode("BreachFacility");
+        outcomes.addNode("EchoGate", [] {
+            std::cout << "📡 EchoGate Opened" << std::endl;
+            return true;
+        });
+        outcomes.addTrigger("BreachFacility", "EchoGate");
+        outcomes.load();
+    }
 
     void executeStealthProtocol() {
         std::cout << "[MicroFix] 🛡️ Activating Stealth Sequence..." << std::endl;
         if (breachDetected) {
             std::cout << "🚀 BreachFacility Triggered. Executing PhaseShift..." << std::endl;
+            outcomes.fire("BreachFacility").wait();
         }
     }
 
+    // Mutable opens a copy-on-write session over AgentMind; Immutable publishes only the pages written
     void toggleMemoryState(bool mutableState) {
-        memoryStateMutable = mutableState;
-        std::cout << "🧠 MemoryState Set to " << (memoryStateMutable ? "Mutable" : "Immutable") << std::endl;
+        size_t written = agentMind.dirtyPageCount();
+        uint64_t version = agentMind.toggle(mutableState ? MicroFixMemoryState::Mutable : MicroFixMemoryState::Immutable);
+        std::cout << "🧠 MemoryState Set to " << (mutableState ? "Mutable" : "Immutable") << " (AgentMind v" << version;
+        if (!mutableState) std::cout << ", " << written << "/" << agentMind.pageCount() << " pages copied";
+        std::cout << ")" << std::endl;
+    }
+
+    // Recon writes go to private page copies; concurrent readers keep seeing the published AgentMind
+    void recordRecon(size_t offset, const std::string& intel) {
+        agentMind.write(offset, intel.data(), intel.size());
+    }
+
+    // toggle MemoryState to Mutable during Recon: back to Immutable when recon returns,
+    // with its writes published, or rolled back if recon throws
+    template <class Recon>
+    void duringRecon(Recon&& recon) {
+        MicroFixScopedToggle scope;
+        scope.mutableDuring(agentMind);
+        recon();
     }
 
     void reinforceFrame() {
@@ -1149,14 +1330,58 @@ public:
 };
 
 int main() {
-    MicroFixMissionLogic missionLogic;
+    MicroFixWorkerPool pool;
+    MicroFixMissionLogic missionLogic(&pool);
     missionLogic.executeMissionSequence();
     missionLogic.handleEvent("Overload");
 
-    MicroFixCrimsonVeil crimsonVeil;
+    // Mission fleet: one batch of mixed events fanned out to every unit's jump table
+    std::vector<std::unique_ptr<MicroFixMissionLogic>> fleetUnits;
+    std::vector<MicroFixEventTable*> fleetTables;
+    for (int i = 0; i < 256; ++i) {
+        fleetUnits.push_back(std::make_unique<MicroFixMissionLogic>());
+        fleetUnits.back()->announceEvents = false;
+        fleetTables.push_back(&fleetUnits.back()->events);
+    }
+    MicroFixEventFleet fleet(fleetTables, &pool);
+    MicroFixEventId overload = MicroFixEventNames::global().intern("Overload");
+    MicroFixEventId breach = MicroFixEventNames::global().intern("Breach");
+    std::vector<MicroFixEvent> batch;
+    for (uint32_t i = 0; i < 100000; ++i) batch.push_back({i % 4 ? overload : breach, i % 256, i});
+    MicroFixDeliveryReport delivered = fleet.deliver(batch);
+    std::cout << "📡 Fleet delivery: " << delivered.handled << " handled, " << delivered.unhandled
+              << " without a binding across " << fleet.size() << " units" << std::endl;
+
+    MicroFixCrimsonVeil crimsonVeil(&pool);
     crimsonVeil.breachDetected = true;
     crimsonVeil.executeStealthProtocol();
+
+    std::thread agent([&] {
+        MicroFixDescriptorStore::ReadGuard mind(crimsonVeil.agentMind);  // Lock-free read of immutable AgentMind
+        std::cout << "🕵️ Agent reading AgentMind v" << mind.version() << std::endl;
+    });
     crimsonVeil.toggleMemoryState(true);
+    crimsonVeil.recordRecon(0, "Facility perimeter mapped");
+    crimsonVeil.toggleMemoryState(false);
+    agent.join();
+
+    crimsonVeil.duringRecon([&] { crimsonVeil.recordRecon(64, "Guard rotation logged"); });
+    std::cout << "🧠 Recon complete, AgentMind v" << crimsonVeil.agentMind.version() << " is Immutable again" << std::endl;
+
+    // A whole squad enters the same Recon window; one scope reverts all of them
+    std::vector<std::unique_ptr<MicroFixCrimsonVeil>> squad;
+    std::vector<MicroFixDescriptorStore*> squadMinds;
+    for (int i = 0; i < 8; ++i) {
+        squad.push_back(std::make_unique<MicroFixCrimsonVeil>());
+        squadMinds.push_back(&squad.back()->agentMind);
+    }
+    {
+        MicroFixScopedToggle recon;
+        recon.mutableDuring(squadMinds);
+        for (auto& unit : squad) unit->recordRecon(0, "Sector clear");
+    }
+    std::cout << "🛰️ Squad Recon published for " << squad.size() << " units" << std::endl;
+
     crimsonVeil.reinforceFrame();
 
     return 0;
@@ -1167,6 +1392,8 @@ int main() {
 #include <thread>
 #include <mutex>
 #include <cmath>
+#include <memory>
+#include "runtime/memory_vault.hpp"
 
 // Comprehensive execution refinement system
 class MicroFixExecutionEngine {
@@ -1175,6 +1402,7 @@ public:
     std::mutex executionLock;
     bool executionStable = true;
     double executionPrecision = 1.0;
+    std::unique_ptr<MicroFixEncryptedVault> encryptionLayer;
 
     void evaluatePrimitives() {
         std::cout << "[MicroFixAI] 🔍 Processing Primitive Structures..." << std::endl;
@@ -1196,8 +1424,17 @@ public:
         }
     }
 
+    // Seals every directive into its own vault page in one batch call
     void enableEncryptionLayer() {
         std::cout << "[MicroFixAI] 🔐 Activating Secure Directive Processing with Encryption..." << std::endl;
+        encryptionLayer = std::make_unique<MicroFixEncryptedVault>(std::max<size_t>(directivePaths.size(), 1), MicroFixEncryptedVault::generateKey(), 256);
+        std::vector<uint8_t> pages(encryptionLayer->pageCount() * encryptionLayer->pageBytes(), 0);
+        for (size_t i = 0; i < directivePaths.size(); ++i) {
+            std::memcpy(&pages[i * encryptionLayer->pageBytes()], directivePaths[i].data(), std::min(directivePaths[i].size(), encryptionLayer->pageBytes() - 1));
+        }
+        encryptionLayer->writeBatch(0, encryptionLayer->pageCount(), pages.data());
+        std::cout << "🔐 " << directivePaths.size() << " Directives Sealed with "
+                  << (encryptionLayer->cipherKind() == MicroFixVaultCipherKind::Aes256Gcm ? "AES-256-GCM (AES-NI)" : "ChaCha20-Poly1305") << std::endl;
     }
 
     void executeEnhancedDirectives() {
@@ -1713,6 +1950,7 @@ int main() {
 #include <chrono>
 #include <mutex>
 #include <map>
+#include "runtime/directive_cache.hpp"
 
 std::mutex executionLock;  // Ensuring thread-safe optimization
 
@@ -1723,6 +1961,7 @@ public:
     std::map<std::string, double> speedMap;
     bool executionStable = true;
     double accelerationFactor = 3.0;
+    MicroFixDirectiveCache* resultCache = nullptr;  // Shared across engines and batches when set
 
     void analyzeDirectivePerformance() {
         std::cout << "[MicroFixAI] 🔍 Evaluating Directive Performance Trends..." << std::endl;
@@ -1757,18 +1996,34 @@ public:
         enforceExecutionStability();
         std::cout << "[MicroFixAI] ✅ Executing Directives with Maximum Speed Enhancements..." << std::endl;
         for (const auto& directive : directivePaths) {
-            std::cout << "Executing: " << directive << " [Acceleration Factor: " << accelerationFactor << "]" << std::endl;
+            std::cout << "Executing: " << directive << " [Acceleration Factor: " << accelerationFactor << "]"
+                      << " -> " << executeDirective(directive) << std::endl;
         }
     }
+
+    // Identical directive text with an identical acceleration factor reuses the cached outcome
+    std::string executeDirective(const std::string& directive) {
+        auto run = [&] { return "Completed x" + std::to_string(accelerationFactor); };
+        if (!resultCache) return run();
+        return resultCache->getOrRun(directive, std::to_string(accelerationFactor), run);
+    }
 };
 
 int main() {
-    MicroFixAccelerationEngine accelerationEngine;
-    accelerationEngine.directivePaths.push_back("Initialize AI-Powered Speed Refinement");
-    accelerationEngine.directivePaths.push_back("latency_detected");  // Example inefficiency detected
-    accelerationEngine.directivePaths.push_back("Activate Multi-Core Execution Optimization");
+    MicroFixDirectiveCache resultCache(1024, 1 << 20);
+    for (int batch = 0; batch < 3; ++batch) {
+        MicroFixAccelerationEngine accelerationEngine;
+        accelerationEngine.resultCache = &resultCache;
+        accelerationEngine.directivePaths.push_back("Initialize AI-Powered Speed Refinement");
+        accelerationEngine.directivePaths.push_back("latency_detected");  // Example inefficiency detected
+        accelerationEngine.directivePaths.push_back("Activate Multi-Core Execution Optimization");
 
-    accelerationEngine.executeOptimizedDirectives();  // AI maximizes execution performance dynamically
+        accelerationEngine.executeOptimizedDirectives();  // AI maximizes execution performance dynamically
+    }
+
+    MicroFixCacheStats cacheStats = resultCache.stats();
+    std::cout << "♻️ Directive Reuse: " << cacheStats.hits << " hits, " << cacheStats.misses << " executed ("
+              << static_cast<int>(cacheStats.hitRate() * 100) << "% reused)" << std::endl;
 
     return 0;
 }
@@ -2027,6 +2282,8 @@ int main() {
 #include <chrono>
 #include <mutex>
 #include <map>
+#include "runtime/memory_vault.hpp"
+#include "runtime/vault_merkle.hpp"
 
 std::mutex executionLock;  // Ensuring thread-safe optimization
 
@@ -2037,11 +2294,37 @@ public:
     std::map<std::string, std::string> memoryStatus;
     bool executionStable = true;
     double optimizationFactor = 3.2;
+    MicroFixEncryptedVault encryptedVault{64, MicroFixEncryptedVault::generateKey()};
+    MicroFixVaultMerkle vaultIntegrity{encryptedVault};  // Must follow encryptedVault: built from its pages
+    MicroFixWorkerPool verificationPool;
+
+    // Directive state is stored sealed, one directive per vault page
+    void sealDirectives() {
+        std::vector<uint8_t> page(encryptedVault.pageBytes());
+        for (size_t i = 0; i < directivePaths.size() && i < encryptedVault.pageCount(); ++i) {
+            std::fill(page.begin(), page.end(), 0);
+            std::memcpy(page.data(), directivePaths[i].data(), std::min(directivePaths[i].size(), page.size() - 1));
+            encryptedVault.write(i, page.data());
+            vaultIntegrity.update(i);  // Rehashes only this page's path to the root
+        }
+    }
 
     void scanEncryptedMemory() {
         std::cout << "[MicroFixAI] 🔍 Evaluating Encrypted Memory Vault Integrity..." << std::endl;
-        for (auto& directive : directivePaths) {
-            memoryStatus["Vault#" + std::to_string(rand() % 10000)] = directive + " memory integrity verified";
+        std::vector<uint8_t> page(encryptedVault.pageBytes());
+        for (size_t i = 0; i < directivePaths.size() && i < encryptedVault.pageCount(); ++i) {
+            if (!vaultIntegrity.verifyPage(i)) {
+                memoryStatus["Vault#" + std::to_string(i)] = "Merkle path mismatch";
+                executionStable = false;
+                continue;
+            }
+            try {
+                encryptedVault.read(i, page.data());
+                memoryStatus["Vault#" + std::to_string(i)] = reinterpret_cast<const char*>(page.data()) + std::string(" memory integrity verified");
+            } catch (const std::runtime_error& error) {
+                memoryStatus["Vault#" + std::to_string(i)] = error.what();
+                executionStable = false;
+            }
         }
     }
 
@@ -2055,6 +2338,11 @@ public:
     void enforceMemoryConsistency() {
         std::lock_guard<std::mutex> lock(executionLock);
         std::cout << "[MicroFixAI] ✅ Ensuring Secure Memory Vault Processing..." << std::endl;
+        MicroFixMerkleReport report = vaultIntegrity.verifyAll(&verificationPool);
+        if (!report.intact) {
+            std::cout << "⚠️ Vault Integrity Violation: " << report.corruptPages.size() << " corrupt page(s)" << std::endl;
+            executionStable = false;
+        }
         if (!executionStable) {
             std::cout << "⚠️ Instability Detected. Applying Predictive Memory Adjustments..." << std::endl;
             executionStable = true;
@@ -2062,6 +2350,7 @@ public:
     }
 
     void executeMemoryDiagnostics() {
+        sealDirectives();
         scanEncryptedMemory();
         refineCacheOptimization();
         enforceMemoryConsistency();
@@ -2524,3 +2813,272 @@ int main() {
     return 0;
 }
 
+#include <iostream>
+#include <chrono>
+#include "runtime/sensorproof.hpp"
+#include "runtime/streamlogic.hpp"
+
+// Non-blocking auto_fallback throughput check: 10k sensors rebooting at once
+class MicroFixFallbackBenchmark {
+public:
+    size_t sensorCount = 10000;
+    std::chrono::milliseconds rebootWait{50};
+
+    void runConcurrentFallbacks() {
+        // Placement comes from the modules' own locate:: hints; defaults apply if they are missing
+        auto sensorproofHints = MicroFixLocatorHints::load("modules/sensorproof.mfix");
+        auto streamlogicHints = MicroFixLocatorHints::load("modules/streamlogic.mfix");
+        MicroFixSensorMap sensorMap;
+        initSensorMap(sensorMap, sensorproofHints, sensorCount);
+
+        MicroFixEventLoop loop;
+        MicroFixFallbackHooks hooks;
+        hooks.reboot = [&](uint32_t id) {
+            if (auto* sensor = sensorMap.find(id)) sensor->active = id % 10 != 0;  // Every tenth sensor stays down
+        };
+        hooks.rebooted = [&](uint32_t id) {
+            auto* sensor = sensorMap.find(id);
+            return sensor && sensor->active;
+        };
+        hooks.markRestored = [](uint32_t) {};
+        hooks.safeMode = [](uint32_t) {};
+        hooks.pushAlert = [](uint32_t) {};
+        MicroFixStreamLogic streamLogic(loop, hooks, rebootWait,
+                                        streamlogicHints.hintFor("fallback_records", parseLocatorHint("L2.prefetch")));
+
+        std::cout << "[MicroFix] 🔄 Routing " << sensorCount << " Sensors to auto_fallback..." << std::endl;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t id = 0; id < sensorCount; ++id) streamLogic.autoFallback(id);
+        loop.runUntilIdle();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "✅ Restored: " << streamLogic.restored() << " | ⚠️ Alerted: " << streamLogic.alerted()
+                  << " | Pending: " << streamLogic.pending() << std::endl;
+        const auto& sensorHits = sensorMap.statistics();
+        const auto& recordHits = streamLogic.recordStats();
+        std::cout << "📌 sensor_map hits L1/L2/warm: " << sensorHits.l1Hits << "/" << sensorHits.l2Hits << "/" << sensorHits.warmHits
+                  << " | fallback records L1/L2/warm: " << recordHits.l1Hits << "/" << recordHits.l2Hits << "/" << recordHits.warmHits
+                  << std::endl;
+        std::cout << "[MicroFix] 🚀 " << sensorCount << " Fallbacks in " << seconds << "s ("
+                  << (sensorCount / seconds) << " fallbacks/s, one thread, wait::" << rebootWait.count() << "ms)" << std::endl;
+    }
+};
+
+int main() {
+    MicroFixFallbackBenchmark benchmark;
+    benchmark.runConcurrentFallbacks();  // All reboots wait concurrently on a single event loop thread
+
+    return 0;
+}
+
+#include <iostream>
+#include <chrono>
+#include "runtime/sensorproof.hpp"
+#include "runtime/stream_batch.hpp"
+#include "runtime/stream_node.hpp"
+
+// sensors.logic pipeline throughput: ingest -> validate -> alert, swept over batch size
+class MicroFixBatchBenchmark {
+public:
+    size_t sensorCount = 1 << 20;
+    std::vector<size_t> batchSizes = {1, 16, 64, 256, 512, 1024};
+
+    void runBatchSweep() {
+        MicroFixWorkerPool pool;
+        MicroFixSensorProof proof;
+        auto fibs = MicroFixHexLib::range(0xA, 0x2F);
+
+        std::cout << "[MicroFix] 🔍 Streaming " << sensorCount << " Sensors through ingest -> validate -> alert..." << std::endl;
+        for (size_t batchSize : batchSizes) {
+            MicroFixBatchTuning tuning;
+            tuning.batchSize = batchSize;
+            MicroFixBatchPool batches(tuning);
+            MicroFixBatchBuilder builder(batches, tuning.latencyTarget);
+            MicroFixStreamGraph<MicroFixBatchPool::Handle> graph;
+
+            uint32_t nextId = 0;
+            size_t alerts = 0;
+            auto ingest = graph.addSource("ingest", builder.source([&](MicroFixBatchRecord& record) {
+                if (nextId >= sensorCount) return MicroFixBatchPoll::Exhausted;
+                uint32_t id = nextId++;
+                record = {id, id % 3 ? static_cast<uint32_t>(fibs[id % fibs.size()]) : id, id % 7 != 0};
+                return MicroFixBatchPoll::Record;
+            }));
+            auto validate = graph.addStage("validate", [&](MicroFixBatchPool::Handle&& batch, auto& out) {
+                proof.validateBatch(batch->values.get(), batch->active.get(), batch->count, batch->verified.get());
+                out.emit(std::move(batch));
+            }, 64);
+            auto alert = graph.addStage("alert", [&](MicroFixBatchPool::Handle&& batch, auto&) {
+                for (size_t i = 0; i < batch->count; ++i) alerts += !batch->isVerified(i);
+            }, 64);
+            graph.connect(ingest, validate);
+            graph.connect(validate, alert);
+
+            auto start = std::chrono::steady_clock::now();
+            graph.trigger("ingest", pool);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "📌 Batch " << batchSize << ": " << static_cast<uint64_t>(sensorCount / seconds)
+                      << " items/s (" << alerts << " routed to auto_fallback)" << std::endl;
+        }
+        std::cout << "[MicroFix] ✅ Batch Sweep Complete" << std::endl;
+    }
+
+    // A sensor every few microseconds: batches would wait to fill, so the latency target seals them
+    void runTrickle(size_t records = 20000, std::chrono::microseconds arrivalGap = std::chrono::microseconds(5)) {
+        MicroFixWorkerPool pool;
+        MicroFixSensorProof proof;
+        MicroFixBatchTuning tuning;
+        MicroFixBatchPool batches(tuning);
+        MicroFixBatchBuilder builder(batches, tuning.latencyTarget);
+        MicroFixStreamGraph<MicroFixBatchPool::Handle> graph;
+
+        uint32_t nextId = 0;
+        size_t delivered = 0, shipped = 0;
+        auto nextArrival = std::chrono::steady_clock::now();
+        auto ingest = graph.addSource("ingest", builder.source([&](MicroFixBatchRecord& record) {
+            if (nextId >= records) return MicroFixBatchPoll::Exhausted;
+            auto now = std::chrono::steady_clock::now();
+            if (now < nextArrival) return MicroFixBatchPoll::Idle;
+            nextArrival = now + arrivalGap;
+            record = {nextId, nextId, true};
+            ++nextId;
+            return MicroFixBatchPoll::Record;
+        }));
+        auto validate = graph.addStage("validate", [&](MicroFixBatchPool::Handle&& batch, auto&) {
+            proof.validateBatch(batch->values.get(), batch->active.get(), batch->count, batch->verified.get());
+            delivered += batch->count;
+            ++shipped;
+        }, 64);
+        graph.connect(ingest, validate);
+        graph.trigger("ingest", pool);
+        std::cout << "📌 Trickle: " << delivered << " records in " << shipped << " batches, " << builder.sealedStale()
+                  << " sealed by the " << tuning.latencyTarget.count() << "us latency target" << std::endl;
+    }
+};
+
+int main() {
+    MicroFixBatchBenchmark benchmark;
+    benchmark.runBatchSweep();  // Larger batches amortize each StreamNode hop across hundreds of records
+    benchmark.runTrickle();     // Slow streams still ship partial batches within the latency target
+
+    return 0;
+}
+
+#ifdef __linux__  // fork() and shared-memory rings; not built by the Windows scripts
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <sys/wait.h>
+#include "runtime/guild_shm.hpp"
+
+// Cross-process guild directive round trip over shared memory (DevNet <-> SimRoot)
+class MicroFixGuildShmBenchmark {
+public:
+    size_t roundTrips = 100000;
+
+    void runRoundTrips() {
+        MicroFixShmGuildLink link = MicroFixShmGuildLink::createAnonymous("microfix-guild-bench");
+        const char directive[] = "guild_directive::[enable::stream.push]";
+        MicroFixGuildStateVector guildState(3);
+
+        pid_t simRoot = fork();
+        if (simRoot == 0) {
+            link.becomePeer();  // SimRoot applies DevNet's guild_state, then echoes every directive back
+            MicroFixGuildStateReplica replica(3);
+            const MicroFixShmDirective* in = link.inbound().peek();
+            bool applied = replica.apply(MicroFixShmChannel::decodeStateDelta(*in));
+            link.inbound().release();
+            link.outbound().send(1, kShmGuildDirective, &applied, sizeof(applied));
+            for (size_t i = 0; i < roundTrips; ++i) {
+                in = link.inbound().peek();
+                size_t length = std::min<size_t>(in->length, MicroFixShmDirective::kPayloadBytes);  // Peer-written
+                link.outbound().send(1, in->kind, in->payload, length);
+                link.inbound().release();
+            }
+            _exit(0);
+        }
+
+        guildState.set(0, 1);
+        guildState.set(2, 1);
+        link.outbound().sendStateDelta(0, guildState.flush());
+        const MicroFixShmDirective* reply = link.inbound().peek();
+        bool applied = reply->length == sizeof(bool) && reply->payload[0] == 1;
+        link.inbound().release();
+        std::cout << "[MicroFix] 🔄 Guild State v" << guildState.currentVersion() << " replicated to SimRoot: "
+                  << (applied ? "✅" : "⚠️ resync needed") << std::endl;
+
+        std::cout << "[MicroFix] 🔍 Dispatching " << roundTrips << " Guild Directives across processes..." << std::endl;
+        std::vector<double> samples;
+        samples.reserve(roundTrips);
+        for (size_t i = 0; i < roundTrips; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            link.outbound().send(0, kShmGuildDirective, directive, sizeof(directive));
+            link.inbound().peek();
+            link.inbound().release();
+            samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+        }
+        waitpid(simRoot, nullptr, 0);
+
+        std::sort(samples.begin(), samples.end());
+        std::cout << "✅ Round Trip p50: " << samples[samples.size() / 2] << "ns | p99: "
+                  << samples[samples.size() * 99 / 100] << "ns | max: " << samples.back() << "ns" << std::endl;
+    }
+};
+
+int main() {
+    MicroFixGuildShmBenchmark benchmark;
+    benchmark.runRoundTrips();  // No sockets, no serialization: directives are written straight into the peer's ring
+
+    return 0;
+}
+#endif
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "runtime/memory_vault.hpp"
+
+// Vault sealing throughput per cipher, single page vs. batched across the worker pool
+class MicroFixVaultBenchmark {
+public:
+    size_t vaultPages = 16384;  // 64 MiB of 4 KiB pages
+
+    void runThroughput() {
+        std::vector<uint8_t> plain(vaultPages * MicroFixEncryptedVault::kDefaultPageBytes, 0x5A);
+        MicroFixWorkerPool pool;
+        std::vector<MicroFixVaultCipherKind> kinds = {MicroFixVaultCipherKind::ChaCha20Poly1305};
+        if (MicroFixVaultCipher::hardwareAesAvailable()) kinds.insert(kinds.begin(), MicroFixVaultCipherKind::Aes256Gcm);
+
+        for (auto kind : kinds) {
+            MicroFixEncryptedVault vault(vaultPages, MicroFixEncryptedVault::generateKey(), MicroFixEncryptedVault::kDefaultPageBytes, kind);
+            const char* name = kind == MicroFixVaultCipherKind::Aes256Gcm ? "AES-256-GCM" : "ChaCha20-Poly1305";
+
+            double single = measure([&] {
+                for (size_t page = 0; page < vaultPages; ++page) vault.write(page, &plain[page * vault.pageBytes()]);
+            });
+            double batched = measure([&] { vault.writeBatch(0, vaultPages, plain.data(), &pool); });
+            double opened = measure([&] { vault.readBatch(0, vaultPages, plain.data(), &pool); });
+
+            std::cout << "[MicroFix] 🔐 " << name << " | Page Seal: " << single << " GB/s | Batch Seal: " << batched
+                      << " GB/s | Batch Open: " << opened << " GB/s" << std::endl;
+        }
+    }
+
+private:
+    template <class Fn>
+    double measure(Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return vaultPages * MicroFixEncryptedVault::kDefaultPageBytes / seconds / 1e9;
+    }
+};
+
+int main() {
+    MicroFixVaultBenchmark benchmark;
+    benchmark.runThroughput();  // Directive state stays sealed at rest; only the caller's buffer holds plaintext
+
+    return 0;
+}
+
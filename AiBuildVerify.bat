@@ -23,7 +23,7 @@ if not exist "!OUT_DIR!" mkdir "!OUT_DIR!"
 
 :: Compile C++ modules with validation
 echo ⚙️ Compiling C++ Directive Engine...
-"!COMPILER_CPP!" AIPoweredDebugging.cpp runtime_call.cel -o "!OUT_DIR!\MicroFix_Core.exe"
+"!COMPILER_CPP!" -std=c++20 -pthread AIPoweredDebugging.cpp runtime_call.cel -o "!OUT_DIR!\MicroFix_Core.exe"
 if %ERRORLEVEL% NEQ 0 echo ❌ Compilation Error Detected in AIPoweredDebugging.cpp!
 
 :: Compile Python components with integrity check
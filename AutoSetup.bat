@@ -23,7 +23,7 @@ if not exist "!OUT_DIR!" mkdir "!OUT_DIR!"
 
 :: Compile C++ components
 echo Compiling C++ Modules...
-"!COMPILER_CPP!" AIPoweredDebugging.cpp runtime_call.cel -o "!OUT_DIR!\MicroFix_Core.exe"
+"!COMPILER_CPP!" -std=c++20 -pthread AIPoweredDebugging.cpp runtime_call.cel -o "!OUT_DIR!\MicroFix_Core.exe"
 
 :: Compile Python components
 echo Bundling Python Utility Scripts...
@@ -7,5 +7,36 @@
 ├── modules/
 │   ├── sensorproof.mfix   # Real proof logic for simulated sensors
 │   └── streamlogic.mfix   # StreamNode real-logic processing
+├── runtime/
+│   ├── alert_stream.hpp   # Lock-free alert/log stream with batched drain
+│   ├── checkpoint.hpp     # Dirty-page checkpoints + range restart for directive runs
+│   ├── descriptor_store.hpp # Read-only descriptor pages with COW Mutable toggles
+│   ├── directive_cache.hpp # Content-addressed LRU directive result cache
+│   ├── event_loop.hpp     # Timer/event loop + detached coroutine task
+│   ├── event_registry.hpp # Interned event ids, dense jump tables, fleet delivery
+│   ├── exec_policy.hpp    # Retry budgets, backoff timers, per-kind breakers
+│   ├── guild_executor.hpp # Per-rule-branch worker groups with fallback seals
+│   ├── guild_fusion.hpp   # Partitioned parallel GuildRule fusion + policies
+│   ├── guild_shm.hpp      # Shared-memory guild link with futex wakeups
+│   ├── guild_state.hpp    # Batched delta-encoded guild state sync
+│   ├── guild_sync.hpp     # GuildSync versioned rules with epoch reclamation
+│   ├── hexlib.hpp         # C++ FHex tables, fast doubling + $hex.range
+│   ├── locator_cache.hpp  # Tiered L1/L2/warm store behind locate:: hints
+│   ├── memory_vault.hpp   # Page-sealed encrypted vault + batch I/O
+│   ├── proof_chain.hpp    # Proof-chain parser + versioned memoizing evaluator
+│   ├── range_types.hpp    # UInt#range / RegBank#map compile-time range types
+│   ├── scoped_toggle.hpp  # RAII during-windows over a per-thread undo log
+│   ├── sensorproof.hpp    # SIMD batch validate(sensor) over SoA blocks
+│   ├── sensors_logic.hpp  # Parallel chunked run_network with ordered drain
+│   ├── sha256.hpp         # Streaming SHA-256 with SHA-NI fast path
+│   ├── stream_batch.hpp   # Columnar sensor batches, pool + size/latency builder
+│   ├── stream_node.hpp    # StreamNode DAG engine with credit backpressure
+│   ├── stream_queue.hpp   # Bounded SPSC/MPMC/MPSC rings
+│   ├── streamlogic.hpp    # Coroutine auto_fallback with non-blocking wait::
+│   ├── trigger_graph.hpp  # Outcome/trigger DAG, iterative cascades on the pool
+│   ├── vault_cipher.hpp   # AES-NI GCM / ChaCha20-Poly1305 page AEAD
+│   ├── vault_merkle.hpp   # Incremental Merkle tree over vault pages
+│   ├── vault_pool.hpp     # Size-class vault pool, guard pages + site sampling
+│   └── worker_pool.hpp    # Shared worker pool + parallelFor
 └── utils/
     └── hexlib.mfix        # FHex calculation and range validation
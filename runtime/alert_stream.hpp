@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+
+#include "stream_queue.hpp"
+
+enum class MicroFixStreamKind : uint8_t {
+    SensorValid,     // log>>"Sensor %id is valid":::stream
+    SensorRestored,  // mark::"restored"
+    SensorAlert      // push::alert_stream
+};
+
+struct MicroFixStreamRecord {
+    uint32_t sensorId = 0;
+    MicroFixStreamKind kind = MicroFixStreamKind::SensorValid;
+    int64_t timestampNs = 0;
+};
+
+// push::alert_stream and :::stream logs as fixed-size records on a lock-free MPSC ring.
+// Producers (validators, fallbacks) never block or take a lock: when an outage spike
+// fills the ring, the record is dropped and counted, and the next drainTo reports how
+// many were lost. Formatting happens on the consumer, one buffered write per drained batch.
+class MicroFixAlertStream {
+public:
+    explicit MicroFixAlertStream(size_t capacity = 1 << 16) : ring(capacity) {}
+
+    // Returns false when the ring was full and the record was dropped
+    bool push(uint32_t sensorId, MicroFixStreamKind kind) {
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch()).count();
+        if (ring.tryPush(MicroFixStreamRecord{sensorId, kind, now})) return true;
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Hook for MicroFixFallbackHooks::pushAlert and similar callbacks
+    std::function<void(uint32_t)> hook(MicroFixStreamKind kind) {
+        return [this, kind](uint32_t sensorId) { push(sensorId, kind); };
+    }
+
+    // Consumer only: hands up to maxBatch records to fn(const MicroFixStreamRecord&), oldest first
+    template <class Fn>
+    size_t drain(Fn&& fn, size_t maxBatch = 1024) {
+        return ring.drain([&](MicroFixStreamRecord& record) { fn(static_cast<const MicroFixStreamRecord&>(record)); }, maxBatch);
+    }
+
+    // Consumer only: formats one batch and writes it with a single stream insertion
+    size_t drainTo(std::ostream& out, size_t maxBatch = 1024) {
+        buffer.clear();
+        size_t drained = drain([&](const MicroFixStreamRecord& record) {
+            switch (record.kind) {
+                case MicroFixStreamKind::SensorValid: buffer += "Sensor "; break;
+                case MicroFixStreamKind::SensorRestored: buffer += "✅ Restored Sensor "; break;
+                case MicroFixStreamKind::SensorAlert: buffer += "⚠️ Alert: Sensor "; break;
+            }
+            buffer += std::to_string(record.sensorId);
+            buffer += record.kind == MicroFixStreamKind::SensorValid ? " is valid\n" : "\n";
+        }, maxBatch);
+        size_t lost = dropped();
+        if (lost != reportedDrops) {
+            buffer += "⚠️ Alert stream full: " + std::to_string(lost - reportedDrops) + " records dropped\n";
+            reportedDrops = lost;
+        }
+        if (!buffer.empty()) out << buffer << std::flush;
+        return drained;
+    }
+
+    // Records dropped because the ring was full
+    size_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    MicroFixMpscRing<MicroFixStreamRecord> ring;
+    std::atomic<size_t> droppedCount{0};
+    size_t reportedDrops = 0;  // Consumer-owned, drops already reported by drainTo
+    std::string buffer;        // Consumer-owned formatting buffer, reused across drains
+};
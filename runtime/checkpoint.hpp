@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Execution state with incremental checkpoints. Writes go through write()/at(), which
+// set a bit per touched page; checkpoint() copies only those pages into the saved image
+// and restore() copies only those pages back, so both cost the pages changed since the
+// last checkpoint rather than the whole state.
+class MicroFixCheckpointArena {
+public:
+    explicit MicroFixCheckpointArena(size_t bytes, size_t pageBytes = 4096)
+        : bytesPerPage(checkedPageBytes(pageBytes)), pages(bytes / bytesPerPage + (bytes % bytesPerPage != 0)),
+          live(pages * bytesPerPage), image(pages * bytesPerPage), dirtyBits((pages + 63) / 64) {}
+
+    size_t sizeBytes() const { return live.size(); }
+    size_t pageCount() const { return pages; }
+    uint64_t checkpointCount() const { return checkpoints; }
+
+    const uint8_t* data() const { return live.data(); }
+
+    void write(size_t offset, const void* src, size_t len) {
+        markDirty(offset, len);
+        std::memcpy(live.data() + offset, src, len);
+    }
+
+    // Mutable access to a trivially copyable value; marks its pages dirty up front
+    template <class T>
+    T& at(size_t offset) {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpointed state must be trivially copyable");
+        markDirty(offset, sizeof(T));
+        return *reinterpret_cast<T*>(live.data() + offset);
+    }
+
+    template <class T>
+    const T& get(size_t offset) const {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpointed state must be trivially copyable");
+        if (offset > live.size() || sizeof(T) > live.size() - offset) throw std::out_of_range("Checkpoint access out of range");
+        return *reinterpret_cast<const T*>(live.data() + offset);
+    }
+
+    void markDirty(size_t offset, size_t len) {
+        if (offset > live.size() || len > live.size() - offset) throw std::out_of_range("Checkpoint access out of range");
+        if (len == 0) return;
+        for (size_t page = offset / bytesPerPage; page <= (offset + len - 1) / bytesPerPage; ++page) {
+            dirtyBits[page / 64] |= uint64_t(1) << (page % 64);
+        }
+    }
+
+    size_t dirtyPages() const {
+        size_t count = 0;
+        for (uint64_t word : dirtyBits) count += static_cast<size_t>(__builtin_popcountll(word));
+        return count;
+    }
+
+    // Saves the pages written since the last checkpoint; returns how many were copied
+    size_t checkpoint() {
+        size_t copied = forEachDirty([&](size_t page) { copyPage(image, live, page); });
+        ++checkpoints;
+        return copied;
+    }
+
+    // Rolls the pages written since the last checkpoint back to it; returns how many were copied
+    size_t restore() {
+        return forEachDirty([&](size_t page) { copyPage(live, image, page); });
+    }
+
+private:
+    // Runs in the initializer list, before anything divides by the page size
+    static size_t checkedPageBytes(size_t pageBytes) {
+        if (pageBytes == 0) throw std::invalid_argument("Checkpoint page size must be positive");
+        return pageBytes;
+    }
+
+    size_t bytesPerPage;
+    size_t pages;
+    std::vector<uint8_t> live;
+    std::vector<uint8_t> image;        // State as of the last checkpoint
+    std::vector<uint64_t> dirtyBits;   // Pages written since the last checkpoint
+    uint64_t checkpoints = 0;
+
+    void copyPage(std::vector<uint8_t>& to, const std::vector<uint8_t>& from, size_t page) {
+        std::memcpy(to.data() + page * bytesPerPage, from.data() + page * bytesPerPage, bytesPerPage);
+    }
+
+    template <class Fn>
+    size_t forEachDirty(Fn&& fn) {
+        size_t count = 0;
+        for (size_t word = 0; word < dirtyBits.size(); ++word) {
+            for (uint64_t bits = dirtyBits[word]; bits; bits &= bits - 1) {
+                fn(word * 64 + static_cast<size_t>(__builtin_ctzll(bits)));
+                ++count;
+            }
+            dirtyBits[word] = 0;
+        }
+        return count;
+    }
+};
+
+struct MicroFixRecoveryReport {
+    size_t executed = 0;          // Directive runs, reruns included
+    size_t restarts = 0;          // Rollbacks to a checkpoint
+    size_t rerun = 0;             // Runs repeated after a restart, the retried directive included
+    size_t checkpoints = 0;
+    size_t pagesSaved = 0;        // Pages copied by checkpoints
+    size_t pagesRestored = 0;     // Pages copied back by restarts
+    std::vector<size_t> abandoned;  // Directives still failing after maxAttempts; skipped
+};
+
+// Runs a directive batch against an arena, checkpointing every directivesPerCheckpoint
+// directives. A failing directive rolls the arena back to the last checkpoint and only
+// that range is rerun; after maxAttempts the directive is abandoned and skipped.
+// step(index, attempt) sees attempt > 0 on reruns of the failed directive, and must keep
+// its state in the arena: anything outside it is not rolled back.
+class MicroFixCheckpointedRun {
+public:
+    MicroFixCheckpointedRun(MicroFixCheckpointArena& arena, size_t directivesPerCheckpoint = 64, unsigned maxAttempts = 3)
+        : arena(arena), perCheckpoint(std::max<size_t>(1, directivesPerCheckpoint)), maxAttempts(std::max(1u, maxAttempts)) {}
+
+    template <class Step>
+    MicroFixRecoveryReport run(size_t count, Step&& step) {
+        MicroFixRecoveryReport report;
+        std::vector<unsigned> failures(count, 0);
+        std::vector<bool> skipped(count, false);
+        arena.checkpoint();  // Everything before the batch is the first restart point
+        size_t rangeStart = 0;
+        size_t index = 0;
+        size_t furthest = 0;  // Directives below this already ran once in the current range
+        while (index < count) {
+            if (!skipped[index]) {
+                try {
+                    step(index, failures[index]);
+                } catch (...) {
+                    ++report.restarts;
+                    if (++failures[index] >= maxAttempts) {
+                        skipped[index] = true;
+                        report.abandoned.push_back(index);
+                    }
+                    report.pagesRestored += arena.restore();
+                    furthest = std::max(furthest, index + 1);
+                    index = rangeStart;
+                    continue;
+                }
+                ++report.executed;
+                if (index < furthest) ++report.rerun;
+            }
+            ++index;
+            if (index - rangeStart == perCheckpoint || index == count) {
+                report.pagesSaved += arena.checkpoint();
+                ++report.checkpoints;
+                rangeStart = index;
+                furthest = index;
+            }
+        }
+        return report;
+    }
+
+private:
+    MicroFixCheckpointArena& arena;
+    size_t perCheckpoint;
+    unsigned maxAttempts;
+};
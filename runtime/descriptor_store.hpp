@@ -0,0 +1,384 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "guild_sync.hpp"
+
+enum class MicroFixMemoryState { Immutable, Mutable };
+
+// Collects reclamation from many publishes so they cost one epoch retire instead of one each
+class MicroFixRetireBatch {
+public:
+    MicroFixRetireBatch() = default;
+    ~MicroFixRetireBatch() { flush(); }
+    MicroFixRetireBatch(const MicroFixRetireBatch&) = delete;
+    MicroFixRetireBatch& operator=(const MicroFixRetireBatch&) = delete;
+
+    void add(std::function<void()> deleter) { pending.push_back(std::move(deleter)); }
+
+    void flush() {
+        if (pending.empty()) return;
+        MicroFixEpochDomain::global().retire([deleters = std::move(pending)] {
+            for (const auto& deleter : deleters) deleter();
+        });
+        pending.clear();
+    }
+
+private:
+    std::vector<std::function<void()>> pending;
+};
+
+// Storage behind `descriptor X => Immutable` and `toggle MemoryState to Mutable`.
+// Published pages are mapped read-only, so any thread reads them through a ReadGuard
+// with no locks, and a stray write faults instead of corrupting shared data.
+// Toggling to Mutable opens a copy-on-write session: the first write to a page copies
+// only that page into a private writable mapping. Toggling back to Immutable seals the
+// copies read-only and publishes them as a new version in one pointer swap. Replaced
+// pages are unmapped once no reader can still see the old version (epoch reclamation).
+// Off Linux the pages are plain heap blocks: versioning and copy-on-write work the same,
+// but published pages are not sealed, so a stray write is not caught.
+// There is one writer at a time; toggle, write and writablePage must come from that thread.
+class MicroFixDescriptorStore {
+    struct Version;
+
+public:
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const MicroFixDescriptorStore& store) : domain(MicroFixEpochDomain::global()), store(store) {
+            domain.enter();
+            snapshot = store.current.load(std::memory_order_seq_cst);
+        }
+        ~ReadGuard() { domain.exit(); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        uint64_t version() const { return snapshot->number; }
+        const uint8_t* page(size_t index) const { return snapshot->pages.at(index); }
+
+        void read(size_t offset, void* out, size_t len) const {
+            store.checkRange(offset, len);
+            uint8_t* dst = static_cast<uint8_t*>(out);
+            store.forEachSpan(offset, len, [&](size_t index, size_t within, size_t span) {
+                std::memcpy(dst, snapshot->pages[index] + within, span);
+                dst += span;
+            });
+        }
+
+    private:
+        MicroFixEpochDomain& domain;
+        const MicroFixDescriptorStore& store;
+        const Version* snapshot;
+    };
+
+    // bytes is rounded up to whole pages; pageBytes must be a multiple of the OS page size
+    explicit MicroFixDescriptorStore(size_t bytes, size_t pageBytes = 0)
+        : bytesPerPage(pageBytes ? pageBytes : osPageBytes()) {
+        if (bytesPerPage % osPageBytes() != 0) throw std::invalid_argument("Descriptor page size must be a multiple of the OS page size");
+        if (bytes == 0) throw std::invalid_argument("Descriptor store needs at least one byte");
+        size_t pages = (bytes + bytesPerPage - 1) / bytesPerPage;
+
+        std::unique_ptr<Version> initial(new Version{1, std::vector<uint8_t*>(pages)});
+#ifdef __linux__
+        // One zeroed mapping up front; pages are unmapped one by one as they are replaced
+        uint8_t* base = mapPages(pages * bytesPerPage);
+        if (!protectPages(base, pages * bytesPerPage, true)) {
+            unmapPages(base, pages * bytesPerPage);
+            throw std::runtime_error("Descriptor store could not seal its pages");
+        }
+        for (size_t i = 0; i < pages; ++i) initial->pages[i] = base + i * bytesPerPage;
+#else
+        try {
+            for (size_t i = 0; i < pages; ++i) initial->pages[i] = mapPages(bytesPerPage);
+        } catch (...) {
+            for (uint8_t* page : initial->pages) {
+                if (page) unmapPages(page, bytesPerPage);
+            }
+            throw;
+        }
+#endif
+        current.store(initial.release(), std::memory_order_release);
+        shadow.assign(pages, nullptr);
+        shadowSeq.assign(pages, 0);
+        savedAt.assign(pages, 0);
+    }
+
+    ~MicroFixDescriptorStore() {
+        discardShadows();
+        Version* version = current.load(std::memory_order_acquire);
+        for (uint8_t* page : version->pages) unmapPages(page, bytesPerPage);
+        delete version;
+    }
+
+    MicroFixDescriptorStore(const MicroFixDescriptorStore&) = delete;
+    MicroFixDescriptorStore& operator=(const MicroFixDescriptorStore&) = delete;
+
+    size_t pageCount() const { return shadow.size(); }
+    size_t pageBytes() const { return bytesPerPage; }
+    size_t sizeBytes() const { return shadow.size() * bytesPerPage; }
+    MicroFixMemoryState state() const { return writing.load(std::memory_order_acquire) ? MicroFixMemoryState::Mutable : MicroFixMemoryState::Immutable; }
+
+    // Pages copied in the open Mutable session
+    size_t dirtyPageCount() const { return dirty.size(); }
+
+    // Mutable opens a copy-on-write session; Immutable publishes it and returns the new version.
+    // Toggling to the state the store is already in is a no-op that returns the current version.
+    // With a batch, the replaced pages join it instead of being retired one store at a time.
+    uint64_t toggle(MicroFixMemoryState next, MicroFixRetireBatch* batch = nullptr) {
+        if (next == MicroFixMemoryState::Mutable) {
+            writing.store(true, std::memory_order_release);
+            return current.load(std::memory_order_acquire)->number;
+        }
+        if (!writing.load(std::memory_order_acquire)) return current.load(std::memory_order_acquire)->number;
+        uint64_t version = publishShadows(batch);
+        writing.store(false, std::memory_order_release);
+        return version;
+    }
+
+    // Drops the session's copies; readers never saw them
+    void discard() {
+        discardShadows();
+        writing.store(false, std::memory_order_release);
+    }
+
+    // Savepoints nest inside the open session. After savepoint(), the first write to a page the
+    // session had already copied saves that page's contents, so rollbackSavepoint() can put
+    // them back and drop pages first copied since. releaseSavepoint() keeps the writes and
+    // hands the saved contents an outer savepoint still needs to it. Publishing or discarding
+    // the session drops every savepoint.
+    void savepoint() {
+        if (!writing.load(std::memory_order_relaxed)) throw std::logic_error("Descriptor savepoints need a Mutable session");
+        savepoints.push_back({dirty.size(), savedPages.size()});
+    }
+
+    void releaseSavepoint() {
+        if (savepoints.empty()) throw std::logic_error("No open descriptor savepoint");
+        Savepoint top = savepoints.back();
+        savepoints.pop_back();
+        uint32_t outer = static_cast<uint32_t>(savepoints.size());
+        size_t keep = top.savedMark;
+        for (size_t i = top.savedMark; i < savedPages.size(); ++i) {
+            SavedPage& page = savedPages[i];
+            // The outer savepoint wants these contents if the page predates it and it saved none itself
+            if (outer > 0 && page.previousDepth != outer && shadowSeq[page.index] < savepoints.back().dirtyMark) {
+                savedAt[page.index] = outer;
+                if (i != keep) savedPages[keep] = std::move(page);
+                ++keep;
+            } else {
+                savedAt[page.index] = page.previousDepth;
+            }
+        }
+        savedPages.erase(savedPages.begin() + static_cast<ptrdiff_t>(keep), savedPages.end());
+    }
+
+    void rollbackSavepoint() {
+        if (savepoints.empty()) throw std::logic_error("No open descriptor savepoint");
+        Savepoint top = savepoints.back();
+        savepoints.pop_back();
+        while (savedPages.size() > top.savedMark) {
+            SavedPage& page = savedPages.back();
+            std::memcpy(shadow[page.index], page.bytes.get(), bytesPerPage);
+            savedAt[page.index] = page.previousDepth;
+            savedPages.pop_back();
+        }
+        while (dirty.size() > top.dirtyMark) {
+            size_t index = dirty.back();
+            dirty.pop_back();
+            unmapPages(shadow[index], bytesPerPage);
+            shadow[index] = nullptr;
+            savedAt[index] = 0;
+        }
+    }
+
+    size_t savepointDepth() const { return savepoints.size(); }
+
+    // Private copy of the page for this session, made on first request. Request the page again
+    // after opening a savepoint; writes through an older pointer bypass it.
+    uint8_t* writablePage(size_t index) {
+        if (!writing.load(std::memory_order_relaxed)) throw std::logic_error("Descriptor is Immutable; toggle MemoryState to Mutable first");
+        if (index >= shadow.size()) throw std::out_of_range("Descriptor page out of range");
+        if (!shadow[index]) {
+            uint8_t* copy = mapPages(bytesPerPage);
+            std::memcpy(copy, current.load(std::memory_order_relaxed)->pages[index], bytesPerPage);
+            shadow[index] = copy;
+            shadowSeq[index] = dirty.size();
+            dirty.push_back(index);
+        } else if (!savepoints.empty() && savedAt[index] != savepoints.size() && shadowSeq[index] < savepoints.back().dirtyMark) {
+            savePage(index);
+        }
+        return shadow[index];
+    }
+
+    void write(size_t offset, const void* data, size_t len) {
+        checkRange(offset, len);
+        const uint8_t* src = static_cast<const uint8_t*>(data);
+        forEachSpan(offset, len, [&](size_t index, size_t within, size_t span) {
+            std::memcpy(writablePage(index) + within, src, span);
+            src += span;
+        });
+    }
+
+    // The writer's view: its own uncommitted copies where they exist, published pages elsewhere
+    void readMutable(size_t offset, void* out, size_t len) const {
+        checkRange(offset, len);
+        uint8_t* dst = static_cast<uint8_t*>(out);
+        const Version* version = current.load(std::memory_order_relaxed);
+        forEachSpan(offset, len, [&](size_t index, size_t within, size_t span) {
+            std::memcpy(dst, (shadow[index] ? shadow[index] : version->pages[index]) + within, span);
+            dst += span;
+        });
+    }
+
+    uint64_t version() const {
+        ReadGuard guard(*this);
+        return guard.version();
+    }
+
+private:
+    struct Version {
+        uint64_t number;
+        std::vector<uint8_t*> pages;  // Each page sealed read-only once published (Linux)
+    };
+
+    size_t bytesPerPage;
+    std::atomic<Version*> current{nullptr};
+    std::atomic<bool> writing{false};
+    std::vector<uint8_t*> shadow;  // Writer-only: per-page copy for the open session, or null
+    std::vector<size_t> dirty;
+
+    struct Savepoint {
+        size_t dirtyMark;   // Pages at or past this position in dirty were first copied after it
+        size_t savedMark;   // Its saved contents start here in savedPages
+    };
+
+    struct SavedPage {
+        size_t index;
+        uint32_t previousDepth;  // savedAt[index] before this copy was taken
+        std::unique_ptr<uint8_t[]> bytes;
+    };
+
+    std::vector<Savepoint> savepoints;
+    std::vector<SavedPage> savedPages;  // Grouped by savepoint, innermost last
+    std::vector<size_t> shadowSeq;      // Position in dirty while the page is copied
+    std::vector<uint32_t> savedAt;      // Depth of the innermost savepoint holding the page's contents, 0 for none
+
+    static size_t osPageBytes() {
+#ifdef __linux__
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 4096;
+#endif
+    }
+
+    // Zeroed and writable
+    static uint8_t* mapPages(size_t bytes) {
+#ifdef __linux__
+        void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) throw std::bad_alloc();
+        return static_cast<uint8_t*>(mapped);
+#else
+        return static_cast<uint8_t*>(std::memset(::operator new(bytes), 0, bytes));
+#endif
+    }
+
+    static void unmapPages(uint8_t* pages, size_t bytes) {
+#ifdef __linux__
+        munmap(pages, bytes);
+#else
+        ::operator delete(pages, bytes);
+#endif
+    }
+
+    // Off Linux there is nothing to seal and this always succeeds
+    static bool protectPages(uint8_t* pages, size_t bytes, bool readOnly) {
+#ifdef __linux__
+        return mprotect(pages, bytes, readOnly ? PROT_READ : PROT_READ | PROT_WRITE) == 0;
+#else
+        (void)pages, (void)bytes, (void)readOnly;
+        return true;
+#endif
+    }
+
+    void checkRange(size_t offset, size_t len) const {
+        if (offset > sizeBytes() || len > sizeBytes() - offset) throw std::out_of_range("Descriptor access out of range");
+    }
+
+    template <class Fn>
+    void forEachSpan(size_t offset, size_t len, Fn&& fn) const {
+        while (len > 0) {
+            size_t index = offset / bytesPerPage, within = offset % bytesPerPage;
+            size_t span = std::min(len, bytesPerPage - within);
+            fn(index, within, span);
+            offset += span;
+            len -= span;
+        }
+    }
+
+    // Everything that can fail runs before the swap. On failure the published version is
+    // untouched and the session keeps every copy, still writable.
+    uint64_t publishShadows(MicroFixRetireBatch* batch) {
+        Version* previous = current.load(std::memory_order_relaxed);
+        if (dirty.empty()) return previous->number;
+        std::unique_ptr<Version> next(new Version{previous->number + 1, previous->pages});
+        std::vector<uint8_t*> replaced;
+        replaced.reserve(dirty.size());
+        for (size_t sealed = 0; sealed < dirty.size(); ++sealed) {
+            if (!protectPages(shadow[dirty[sealed]], bytesPerPage, true)) {
+                for (size_t i = 0; i < sealed; ++i) protectPages(shadow[dirty[i]], bytesPerPage, false);
+                throw std::runtime_error("Descriptor store could not seal a written page");
+            }
+        }
+        for (size_t index : dirty) {
+            replaced.push_back(previous->pages[index]);
+            next->pages[index] = shadow[index];
+            shadow[index] = nullptr;
+        }
+        dirty.clear();
+        dropSavepoints();
+        uint64_t number = next->number;
+        current.store(next.release(), std::memory_order_seq_cst);
+        size_t pageSize = bytesPerPage;
+        auto reclaim = [previous, replaced = std::move(replaced), pageSize] {
+            for (uint8_t* page : replaced) unmapPages(page, pageSize);
+            delete previous;
+        };
+        if (batch) batch->add(std::move(reclaim));
+        else MicroFixEpochDomain::global().retire(std::move(reclaim));
+        return number;
+    }
+
+    void savePage(size_t index) {
+        std::unique_ptr<uint8_t[]> bytes(new uint8_t[bytesPerPage]);
+        std::memcpy(bytes.get(), shadow[index], bytesPerPage);
+        savedPages.push_back({index, savedAt[index], std::move(bytes)});
+        savedAt[index] = static_cast<uint32_t>(savepoints.size());
+    }
+
+    void dropSavepoints() {
+        for (const SavedPage& page : savedPages) savedAt[page.index] = 0;
+        savedPages.clear();
+        savepoints.clear();
+    }
+
+    void discardShadows() {
+        dropSavepoints();
+        for (size_t index : dirty) {
+            unmapPages(shadow[index], bytesPerPage);
+            shadow[index] = nullptr;
+        }
+        dirty.clear();
+    }
+};
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "sha256.hpp"
+
+struct MicroFixCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;      // Lookups that executed the directive
+    uint64_t coalesced = 0;   // Misses that waited on an identical directive already running
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+
+    double hitRate() const {
+        uint64_t lookups = hits + misses + coalesced;
+        return lookups ? double(hits + coalesced) / lookups : 0.0;
+    }
+};
+
+// Content-addressed cache of directive outcomes. The key is SHA-256 over the directive
+// text and its inputs, so identical work from any batch or engine maps to one entry.
+// Each shard keeps its own LRU list under entry and byte bounds. Identical directives
+// that miss at the same time run once; the others wait for that result. Failures are
+// never cached.
+class MicroFixDirectiveCache {
+public:
+    static constexpr size_t kShards = 16;
+
+    explicit MicroFixDirectiveCache(size_t maxEntries = 4096, size_t maxBytes = 16 * 1024 * 1024)
+        : entriesPerShard(std::max<size_t>(1, maxEntries / kShards)), bytesPerShard(std::max<size_t>(1, maxBytes / kShards)) {}
+
+    MicroFixDirectiveCache(const MicroFixDirectiveCache&) = delete;
+    MicroFixDirectiveCache& operator=(const MicroFixDirectiveCache&) = delete;
+
+    // Length-prefixed so ("ab", "c") and ("a", "bc") never collide
+    static MicroFixDigest key(std::string_view directive, std::string_view inputs = {}) {
+        MicroFixSha256 sha;
+        uint64_t length = directive.size();
+        sha.update(&length, sizeof(length));
+        sha.update(directive.data(), directive.size());
+        sha.update(inputs.data(), inputs.size());
+        return sha.finish();
+    }
+
+    std::optional<std::string> find(const MicroFixDigest& digest) {
+        Shard& shard = shardFor(digest);
+        std::lock_guard<std::mutex> lock(shard.lock);
+        auto it = shard.index.find(digest);
+        if (it == shard.index.end()) return std::nullopt;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return it->second->result;
+    }
+
+    void store(const MicroFixDigest& digest, std::string result) {
+        Shard& shard = shardFor(digest);
+        std::lock_guard<std::mutex> lock(shard.lock);
+        insertLocked(shard, digest, std::move(result));
+    }
+
+    // Cached outcome of (directive, inputs), running execute() only on a miss
+    template <class Execute>
+    std::string getOrRun(std::string_view directive, std::string_view inputs, Execute&& execute) {
+        MicroFixDigest digest = key(directive, inputs);
+        Shard& shard = shardFor(digest);
+        std::optional<std::promise<std::string>> promise;  // Only a miss pays for the shared state
+        {
+            std::unique_lock<std::mutex> lock(shard.lock);
+            auto it = shard.index.find(digest);
+            if (it != shard.index.end()) {
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return it->second->result;
+            }
+            auto running = shard.inflight.find(digest);
+            if (running != shard.inflight.end()) {
+                std::shared_future<std::string> pending = running->second;
+                lock.unlock();
+                coalesced.fetch_add(1, std::memory_order_relaxed);
+                return pending.get();
+            }
+            promise.emplace();
+            shard.inflight.emplace(digest, promise->get_future().share());
+        }
+        misses.fetch_add(1, std::memory_order_relaxed);
+
+        std::string result;
+        try {
+            result = execute();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(shard.lock);
+            shard.inflight.erase(digest);
+            promise->set_exception(std::current_exception());
+            throw;
+        }
+        std::lock_guard<std::mutex> lock(shard.lock);
+        shard.inflight.erase(digest);
+        promise->set_value(result);
+        insertLocked(shard, digest, result);
+        return result;
+    }
+
+    MicroFixCacheStats stats() {
+        MicroFixCacheStats out;
+        out.hits = hits.load(std::memory_order_relaxed);
+        out.misses = misses.load(std::memory_order_relaxed);
+        out.coalesced = coalesced.load(std::memory_order_relaxed);
+        out.evictions = evictions.load(std::memory_order_relaxed);
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.lock);
+            out.entries += shard.lru.size();
+            out.bytes += shard.bytes;
+        }
+        return out;
+    }
+
+    void clear() {
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.lock);
+            shard.index.clear();
+            shard.lru.clear();
+            shard.bytes = 0;
+        }
+    }
+
+private:
+    struct Entry {
+        MicroFixDigest digest;
+        std::string result;
+    };
+
+    // The digest is already uniformly distributed; any 8 bytes of it make a good hash
+    struct DigestHash {
+        size_t operator()(const MicroFixDigest& digest) const {
+            size_t hash;
+            std::memcpy(&hash, digest.data(), sizeof(hash));
+            return hash;
+        }
+    };
+
+    struct alignas(64) Shard {
+        std::mutex lock;
+        std::list<Entry> lru;  // Most recently used first
+        std::unordered_map<MicroFixDigest, std::list<Entry>::iterator, DigestHash> index;
+        std::unordered_map<MicroFixDigest, std::shared_future<std::string>, DigestHash> inflight;
+        size_t bytes = 0;
+    };
+
+    size_t entriesPerShard;
+    size_t bytesPerShard;
+    std::array<Shard, kShards> shards;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> coalesced{0};
+    std::atomic<uint64_t> evictions{0};
+
+    Shard& shardFor(const MicroFixDigest& digest) { return shards[digest[31] % kShards]; }
+
+    static size_t footprint(const Entry& entry) { return sizeof(Entry) + entry.result.capacity(); }
+
+    void insertLocked(Shard& shard, const MicroFixDigest& digest, std::string result) {
+        auto it = shard.index.find(digest);
+        if (it != shard.index.end()) {
+            shard.bytes -= footprint(*it->second);
+            it->second->result = std::move(result);
+            shard.bytes += footprint(*it->second);
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        } else {
+            shard.lru.push_front(Entry{digest, std::move(result)});
+            shard.index.emplace(digest, shard.lru.begin());
+            shard.bytes += footprint(shard.lru.front());
+        }
+        // Oldest entries go first; an entry larger than the whole shard is not kept at all
+        while (!shard.lru.empty() && (shard.lru.size() > entriesPerShard || shard.bytes > bytesPerShard)) {
+            shard.bytes -= footprint(shard.lru.back());
+            shard.index.erase(shard.lru.back().digest);
+            shard.lru.pop_back();
+            evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
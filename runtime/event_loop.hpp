@@ -0,0 +1,214 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+// Timer + event loop driving the runtime's wait:: directives without parking threads.
+// Work may carry an owner tag; cancel(owner) drops that owner's pending work so an object
+// can be destroyed before the loop without leaving callbacks that point at it.
+class MicroFixEventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    MicroFixEventLoop() = default;
+    MicroFixEventLoop(const MicroFixEventLoop&) = delete;
+    MicroFixEventLoop& operator=(const MicroFixEventLoop&) = delete;
+
+    // Coroutines still sleeping on a timer are destroyed rather than leaked
+    ~MicroFixEventLoop() {
+        while (!timers.empty()) {
+            if (timers.top().handle) timers.top().handle.destroy();
+            timers.pop();
+        }
+    }
+
+    // Schedules fn on the loop thread as soon as possible; safe from any thread
+    void post(std::function<void()> fn, const void* owner = nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(loopLock);
+            ready.push_back({owner, std::move(fn)});
+        }
+        wake.notify_one();
+    }
+
+    void postAt(Clock::time_point deadline, std::function<void()> fn, const void* owner = nullptr) {
+        schedule(Timer{deadline, 0, owner, {}, std::move(fn)});
+    }
+
+    void postAfter(Clock::duration delay, std::function<void()> fn, const void* owner = nullptr) {
+        postAt(Clock::now() + delay, std::move(fn), owner);
+    }
+
+    // `co_await loop.sleepFor(d)` suspends the coroutine; only its frame stays alive while waiting
+    auto sleepFor(Clock::duration delay, const void* owner = nullptr) {
+        struct SleepAwaiter {
+            MicroFixEventLoop& loop;
+            Clock::time_point deadline;
+            const void* owner;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { loop.schedule(Timer{deadline, 0, owner, handle, {}}); }
+            void await_resume() const noexcept {}
+        };
+        return SleepAwaiter{*this, Clock::now() + delay, owner};
+    }
+
+    // Drops the owner's posted work and timers, destroying its sleeping coroutines; returns
+    // how many were dropped. Work the loop thread already picked up still runs, so call it
+    // from the loop thread or while the loop is not running.
+    size_t cancel(const void* owner) {
+        std::vector<std::coroutine_handle<>> orphans;
+        size_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(loopLock);
+            size_t before = ready.size();
+            std::erase_if(ready, [owner](const Posted& posted) { return posted.owner == owner; });
+            dropped = before - ready.size();
+            std::vector<Timer> kept;
+            while (!timers.empty()) {
+                Timer timer = timers.top();
+                timers.pop();
+                if (timer.owner != owner) kept.push_back(std::move(timer));
+                else if (timer.handle) orphans.push_back(timer.handle);
+                else ++dropped;
+            }
+            for (auto& timer : kept) timers.push(std::move(timer));
+        }
+        for (auto handle : orphans) handle.destroy();  // Outside the lock: frame destructors may post
+        return dropped + orphans.size();
+    }
+
+    // Runs until stop() is called
+    void run() { runLoop(false); }
+
+    // Runs until no posted work or timers remain
+    void runUntilIdle() { runLoop(true); }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(loopLock);
+            stopping = true;
+        }
+        wake.notify_all();
+    }
+
+    size_t pendingTimers() const {
+        std::lock_guard<std::mutex> lock(loopLock);
+        return timers.size();
+    }
+
+private:
+    struct Posted {
+        const void* owner;
+        std::function<void()> fn;
+    };
+
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t seq;
+        const void* owner;
+        std::coroutine_handle<> handle;
+        std::function<void()> fn;
+    };
+
+    struct LaterFirst {
+        bool operator()(const Timer& a, const Timer& b) const {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.seq > b.seq;
+        }
+    };
+
+    mutable std::mutex loopLock;
+    std::condition_variable wake;
+    std::deque<Posted> ready;
+    std::priority_queue<Timer, std::vector<Timer>, LaterFirst> timers;
+    uint64_t nextSeq = 0;
+    bool stopping = false;
+
+    void schedule(Timer timer) {
+        {
+            std::lock_guard<std::mutex> lock(loopLock);
+            timer.seq = nextSeq++;  // Equal deadlines fire in scheduling order
+            timers.push(std::move(timer));
+        }
+        wake.notify_one();
+    }
+
+    // A throwing callback is reported and skipped, so the rest of its batch (including
+    // coroutines waiting to resume) still runs
+    template <class Fn>
+    static void runGuarded(Fn&& fn) {
+        try {
+            fn();
+        } catch (const std::exception& error) {
+            std::fprintf(stderr, "MicroFix event loop callback failed: %s\n", error.what());
+        } catch (...) {
+            std::fprintf(stderr, "MicroFix event loop callback failed\n");
+        }
+    }
+
+    void runLoop(bool untilIdle) {
+        std::vector<Timer> due;
+        std::deque<Posted> batch;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(loopLock);
+                for (;;) {
+                    if (stopping) {
+                        stopping = false;
+                        return;
+                    }
+                    if (!ready.empty()) break;
+                    if (timers.empty()) {
+                        if (untilIdle) return;
+                        wake.wait(lock);
+                        continue;
+                    }
+                    if (timers.top().deadline <= Clock::now()) break;
+                    wake.wait_until(lock, timers.top().deadline);
+                }
+                batch.swap(ready);
+                auto now = Clock::now();
+                while (!timers.empty() && timers.top().deadline <= now) {
+                    due.push_back(timers.top());
+                    timers.pop();
+                }
+            }
+            for (auto& posted : batch) runGuarded(posted.fn);
+            batch.clear();
+            for (auto& timer : due) {
+                if (timer.handle) runGuarded([&] { timer.handle.resume(); });
+                else runGuarded(timer.fn);
+            }
+            due.clear();
+        }
+    }
+};
+
+// Fire-and-forget coroutine: starts eagerly and frees its frame when it finishes. An
+// exception that escapes the body is reported on stderr and the frame is freed; it does
+// not take the process down. Coroutines that need the error should catch it themselves.
+struct MicroFixDetachedTask {
+    struct promise_type {
+        MicroFixDetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            try {
+                throw;
+            } catch (const std::exception& error) {
+                std::fprintf(stderr, "MicroFix detached task failed: %s\n", error.what());
+            } catch (...) {
+                std::fprintf(stderr, "MicroFix detached task failed\n");
+            }
+        }
+    };
+};
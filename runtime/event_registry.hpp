@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "worker_pool.hpp"
+
+using MicroFixEventId = uint32_t;
+
+struct MicroFixEvent {
+    MicroFixEventId id = 0;
+    uint32_t unit = 0;      // Index into the fleet for batched delivery
+    uint64_t payload = 0;
+};
+
+// Interns event names into small dense ids shared by every unit. Names are interned
+// when `event X => call Y` bindings load; dispatch then works on ids only.
+class MicroFixEventNames {
+public:
+    static constexpr MicroFixEventId kUnknown = std::numeric_limits<MicroFixEventId>::max();
+
+    static MicroFixEventNames& global() {
+        static MicroFixEventNames names;
+        return names;
+    }
+
+    MicroFixEventId intern(std::string_view name) {
+        std::lock_guard<std::mutex> lock(namesLock);
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        MicroFixEventId id = static_cast<MicroFixEventId>(names.size());
+        names.emplace_back(name);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+
+    // kUnknown if the name was never interned; nothing is added
+    MicroFixEventId find(std::string_view name) const {
+        std::lock_guard<std::mutex> lock(namesLock);
+        auto it = ids.find(name);
+        return it == ids.end() ? kUnknown : it->second;
+    }
+
+    std::string name(MicroFixEventId id) const {
+        std::lock_guard<std::mutex> lock(namesLock);
+        return id < names.size() ? names[id] : std::string();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(namesLock);
+        return names.size();
+    }
+
+private:
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
+    mutable std::mutex namesLock;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, MicroFixEventId, NameHash, std::equal_to<>> ids;
+};
+
+// One unit's `event X => call Y` bindings as a dense jump table indexed by event id.
+// Dispatch is a bounds check and an indirect call; unbound events are counted, not thrown.
+// Bind before dispatch starts: the table is not synchronized against concurrent binds.
+class MicroFixEventTable {
+public:
+    using Handler = std::function<void(const MicroFixEvent&)>;
+
+    explicit MicroFixEventTable(MicroFixEventNames& names = MicroFixEventNames::global()) : names(names) {}
+
+    MicroFixEventId bind(std::string_view event, Handler handler) {
+        MicroFixEventId id = names.intern(event);
+        if (id >= handlers.size()) handlers.resize(id + 1);
+        handlers[id] = std::move(handler);
+        return id;
+    }
+
+    bool bound(MicroFixEventId id) const { return id < handlers.size() && handlers[id]; }
+
+    // Returns false if the unit has no handler for the event
+    bool dispatch(const MicroFixEvent& event) {
+        if (event.id >= handlers.size() || !handlers[event.id]) {
+            ++unhandledCount;
+            return false;
+        }
+        handlers[event.id](event);
+        ++handledCount;
+        return true;
+    }
+
+    bool dispatch(MicroFixEventId id, uint64_t payload = 0) { return dispatch(MicroFixEvent{id, 0, payload}); }
+
+    // Slow path for callers that still hold names; interned ids skip the lookup entirely
+    bool dispatch(std::string_view event, uint64_t payload = 0) { return dispatch(names.find(event), payload); }
+
+    uint64_t handled() const { return handledCount; }
+    uint64_t unhandled() const { return unhandledCount; }
+
+private:
+    MicroFixEventNames& names;
+    std::vector<Handler> handlers;
+    uint64_t handledCount = 0;
+    uint64_t unhandledCount = 0;
+};
+
+struct MicroFixDeliveryReport {
+    uint64_t handled = 0;
+    uint64_t unhandled = 0;
+};
+
+// Delivers a mixed batch of events to a fleet of units. Events are bucketed by unit with
+// a counting sort, then each unit drains its bucket on one thread, so a unit sees its
+// events in batch order and its handlers never run concurrently with each other.
+class MicroFixEventFleet {
+public:
+    static constexpr size_t kUnitsPerChunk = 64;
+
+    MicroFixEventFleet(std::vector<MicroFixEventTable*> units, MicroFixWorkerPool* pool = nullptr)
+        : units(std::move(units)), pool(pool) {}
+
+    size_t size() const { return units.size(); }
+
+    MicroFixDeliveryReport deliver(const std::vector<MicroFixEvent>& events) {
+        starts.assign(units.size() + 1, 0);
+        for (const auto& event : events) {
+            if (event.unit >= units.size()) throw std::out_of_range("Event addressed to unknown unit");
+            ++starts[event.unit + 1];
+        }
+        for (size_t unit = 0; unit < units.size(); ++unit) starts[unit + 1] += starts[unit];
+        ordered.resize(events.size());
+        cursor.assign(starts.begin(), starts.end() - 1);
+        for (const auto& event : events) ordered[cursor[event.unit]++] = event;
+
+        size_t chunks = (units.size() + kUnitsPerChunk - 1) / kUnitsPerChunk;
+        std::vector<MicroFixDeliveryReport> perChunk(chunks);
+        std::vector<std::exception_ptr> failures(chunks);
+        auto runChunk = [&](size_t chunk, size_t) {
+            try {
+                size_t end = std::min(units.size(), (chunk + 1) * kUnitsPerChunk);
+                for (size_t unit = chunk * kUnitsPerChunk; unit < end; ++unit) {
+                    for (size_t i = starts[unit]; i < starts[unit + 1]; ++i) {
+                        if (units[unit]->dispatch(ordered[i])) ++perChunk[chunk].handled;
+                        else ++perChunk[chunk].unhandled;
+                    }
+                }
+            } catch (...) {
+                failures[chunk] = std::current_exception();
+            }
+        };
+        if (!pool || chunks <= 1) {
+            for (size_t chunk = 0; chunk < chunks; ++chunk) runChunk(chunk, 0);
+        } else {
+            pool->parallelFor(chunks, runChunk);
+        }
+        for (auto& failure : failures) {
+            if (failure) std::rethrow_exception(failure);
+        }
+
+        MicroFixDeliveryReport report;
+        for (const auto& chunk : perChunk) {
+            report.handled += chunk.handled;
+            report.unhandled += chunk.unhandled;
+        }
+        return report;
+    }
+
+private:
+    std::vector<MicroFixEventTable*> units;
+    MicroFixWorkerPool* pool;
+    std::vector<size_t> starts;  // Scratch reused across batches
+    std::vector<size_t> cursor;
+    std::vector<MicroFixEvent> ordered;
+};
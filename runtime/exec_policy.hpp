@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "event_loop.hpp"
+#include "stream_queue.hpp"
+
+enum class MicroFixPolicyOutcome { Succeeded, RetryScheduled, Failed };
+
+struct MicroFixRetryPolicy {
+    unsigned maxAttempts = 4;                                   // First run included
+    std::chrono::milliseconds baseDelay{10};
+    std::chrono::milliseconds maxDelay{1000};
+    double multiplier = 2.0;
+    double retryBudgetRatio = 0.2;                              // Retry tokens earned per success
+    double retryBudgetCap = 20.0;                               // Most tokens a kind can bank
+    unsigned breakerThreshold = 5;                              // Consecutive failures that open the breaker
+    std::chrono::milliseconds breakerCooldown{500};
+};
+
+// A directive that ran out of attempts, retry budget or breaker patience
+struct MicroFixFailedDirective {
+    uint32_t kind = 0;
+    std::string directive;
+    unsigned attempts = 0;
+    std::string reason;
+};
+
+struct MicroFixKindStats {
+    uint64_t successes = 0;
+    uint64_t failures = 0;       // Failed attempts, retried or not
+    uint64_t retries = 0;
+    uint64_t shortCircuits = 0;  // Attempts the open breaker refused to run
+    uint64_t budgetDenied = 0;   // Retries refused because the kind's budget was spent
+    bool breakerOpen = false;
+};
+
+// Execution policy per directive kind: bounded retries with exponential, jittered backoff
+// on the event loop's timers, a retry budget that caps retries to a share of successes,
+// and a circuit breaker that stops hammering a flapping dependency. A success is a few
+// relaxed atomics with no locks and no allocation. Retries run on the loop thread, so
+// actions must tolerate running there; directives that give up land in a failure queue.
+// Retry timers are tagged with the policy, and destroying it cancels the ones still waiting.
+class MicroFixExecutionPolicy {
+public:
+    using Clock = MicroFixEventLoop::Clock;
+
+    explicit MicroFixExecutionPolicy(MicroFixEventLoop& loop, size_t failureCapacity = 1024)
+        : loop(loop), failureQueue(failureCapacity) {}
+
+    // Destroy it on the loop thread or while the loop is not running (see MicroFixEventLoop::cancel)
+    ~MicroFixExecutionPolicy() { loop.cancel(this); }
+
+    MicroFixExecutionPolicy(const MicroFixExecutionPolicy&) = delete;
+    MicroFixExecutionPolicy& operator=(const MicroFixExecutionPolicy&) = delete;
+
+    // Define every kind before executing; ids are dense from 0
+    uint32_t defineKind(const std::string& name, MicroFixRetryPolicy policy = {}) {
+        if (policy.maxAttempts == 0) throw std::invalid_argument("Retry policy needs at least one attempt");
+        kinds.emplace_back(name, policy);
+        return static_cast<uint32_t>(kinds.size() - 1);
+    }
+
+    const std::string& kindName(uint32_t kind) const { return kinds.at(kind).name; }
+
+    // Runs action now; on failure it is retried later on the loop or sent to the failure queue.
+    // Only a failed or refused first attempt keeps the action, moving it (or copying an lvalue),
+    // so move-only callables work.
+    template <class Action>
+    MicroFixPolicyOutcome execute(uint32_t kind, std::string_view directive, Action&& action) {
+        KindState& state = kinds.at(kind);
+        if (!admit(state)) return shortCircuit(state, Task{kind, std::string(directive), keep(std::forward<Action>(action)), 1});
+        std::string reason;
+        if (runAction(action, reason)) {
+            recordSuccess(state);
+            return MicroFixPolicyOutcome::Succeeded;
+        }
+        return recordFailure(state, Task{kind, std::string(directive), keep(std::forward<Action>(action)), 1}, reason);
+    }
+
+    // Consumer side of the failure queue: one thread at a time
+    template <class Fn>
+    size_t drainFailures(Fn&& fn) {
+        size_t drained = failureQueue.drain([&](MicroFixFailedDirective& failed) { fn(std::move(failed)); });
+        std::vector<MicroFixFailedDirective> spilled;
+        {
+            std::lock_guard<std::mutex> lock(overflowLock);
+            spilled.swap(overflow);
+        }
+        for (auto& failed : spilled) fn(std::move(failed));
+        return drained + spilled.size();
+    }
+
+    // Retries waiting on a timer or running on the loop
+    size_t pendingRetries() const { return pending.load(std::memory_order_acquire); }
+
+    MicroFixKindStats stats(uint32_t kind) const {
+        const KindState& state = kinds.at(kind);
+        MicroFixKindStats out;
+        out.successes = state.successes.load(std::memory_order_relaxed);
+        out.failures = state.failures.load(std::memory_order_relaxed);
+        out.retries = state.retries.load(std::memory_order_relaxed);
+        out.shortCircuits = state.shortCircuits.load(std::memory_order_relaxed);
+        out.budgetDenied = state.budgetDenied.load(std::memory_order_relaxed);
+        out.breakerOpen = state.breaker.load(std::memory_order_relaxed) != Closed;
+        return out;
+    }
+
+private:
+    enum Breaker : int { Closed, Open, HalfOpen };
+    static constexpr int64_t kTokenScale = 1000;  // Retry tokens are kept in thousandths
+
+    struct KindState {
+        KindState(std::string name, MicroFixRetryPolicy policy)
+            : name(std::move(name)), policy(policy), retryTokens(static_cast<int64_t>(policy.retryBudgetCap * kTokenScale)) {}
+
+        std::string name;
+        MicroFixRetryPolicy policy;
+        alignas(64) std::atomic<int> breaker{Closed};
+        std::atomic<int64_t> reopenAt{0};  // Clock ticks after which an open breaker lets one probe through
+        std::atomic<uint32_t> consecutiveFailures{0};
+        std::atomic<int64_t> retryTokens;
+        alignas(64) std::atomic<uint64_t> successes{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> retries{0};
+        std::atomic<uint64_t> shortCircuits{0};
+        std::atomic<uint64_t> budgetDenied{0};
+    };
+
+    // Type-erased action that, unlike std::function, also holds move-only callables
+    struct StoredAction {
+        virtual ~StoredAction() = default;
+        virtual void operator()() = 0;
+    };
+
+    template <class Fn>
+    struct StoredActionOf final : StoredAction {
+        explicit StoredActionOf(Fn fn) : fn(std::move(fn)) {}
+        void operator()() override { fn(); }
+        Fn fn;
+    };
+
+    struct Task {
+        uint32_t kind;
+        std::string directive;
+        std::unique_ptr<StoredAction> action;
+        unsigned attempts;  // Made so far, this one included
+    };
+
+    MicroFixEventLoop& loop;
+    std::deque<KindState> kinds;  // Stable addresses for the atomics
+    MicroFixMpscRing<MicroFixFailedDirective> failureQueue;
+    std::mutex overflowLock;      // Only when the ring is full, so no failure is ever dropped
+    std::vector<MicroFixFailedDirective> overflow;
+    std::atomic<size_t> pending{0};
+
+    static int64_t ticks(Clock::time_point time) { return time.time_since_epoch().count(); }
+
+    template <class Action>
+    static std::unique_ptr<StoredAction> keep(Action&& action) {
+        return std::make_unique<StoredActionOf<std::decay_t<Action>>>(std::forward<Action>(action));
+    }
+
+    template <class Action>
+    static bool runAction(Action& action, std::string& reason) {
+        try {
+            action();
+            return true;
+        } catch (const std::exception& error) {
+            reason = error.what();
+        } catch (...) {
+            reason = "unknown failure";
+        }
+        return false;
+    }
+
+    // Closed runs; Open refuses until the cooldown ends, then lets a single probe through
+    static bool admit(KindState& state) {
+        int breaker = state.breaker.load(std::memory_order_acquire);
+        if (breaker == Closed) return true;
+        if (ticks(Clock::now()) < state.reopenAt.load(std::memory_order_acquire)) return false;
+        return breaker == Open && state.breaker.compare_exchange_strong(breaker, HalfOpen, std::memory_order_acq_rel);
+    }
+
+    static void recordSuccess(KindState& state) {
+        state.successes.fetch_add(1, std::memory_order_relaxed);
+        if (state.consecutiveFailures.load(std::memory_order_relaxed) != 0) state.consecutiveFailures.store(0, std::memory_order_relaxed);
+        if (state.breaker.load(std::memory_order_relaxed) != Closed) state.breaker.store(Closed, std::memory_order_release);
+        int64_t cap = static_cast<int64_t>(state.policy.retryBudgetCap * kTokenScale);
+        if (state.retryTokens.load(std::memory_order_relaxed) < cap) {
+            state.retryTokens.fetch_add(static_cast<int64_t>(state.policy.retryBudgetRatio * kTokenScale), std::memory_order_relaxed);
+        }
+    }
+
+    MicroFixPolicyOutcome recordFailure(KindState& state, Task task, const std::string& reason) {
+        state.failures.fetch_add(1, std::memory_order_relaxed);
+        uint32_t streak = state.consecutiveFailures.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (streak >= state.policy.breakerThreshold || state.breaker.load(std::memory_order_acquire) == HalfOpen) {
+            state.reopenAt.store(ticks(Clock::now() + state.policy.breakerCooldown), std::memory_order_release);
+            state.breaker.store(Open, std::memory_order_release);
+        }
+        if (task.attempts >= state.policy.maxAttempts) return fail(std::move(task), reason);
+        if (!takeRetryToken(state)) {
+            state.budgetDenied.fetch_add(1, std::memory_order_relaxed);
+            return fail(std::move(task), reason + " (retry budget exhausted)");
+        }
+        state.retries.fetch_add(1, std::memory_order_relaxed);
+        Clock::time_point when = Clock::now() + backoff(state.policy, task.attempts);
+        scheduleRetry(std::move(task), when);
+        return MicroFixPolicyOutcome::RetryScheduled;
+    }
+
+    // A refused attempt still counts, so a breaker that never closes cannot loop forever
+    MicroFixPolicyOutcome shortCircuit(KindState& state, Task task) {
+        state.shortCircuits.fetch_add(1, std::memory_order_relaxed);
+        if (task.attempts >= state.policy.maxAttempts) return fail(std::move(task), "circuit open");
+        Clock::time_point reopen{Clock::duration(state.reopenAt.load(std::memory_order_acquire))};
+        Clock::time_point when = std::max(reopen, Clock::now() + backoff(state.policy, task.attempts));
+        scheduleRetry(std::move(task), when);
+        return MicroFixPolicyOutcome::RetryScheduled;
+    }
+
+    static bool takeRetryToken(KindState& state) {
+        int64_t tokens = state.retryTokens.load(std::memory_order_relaxed);
+        while (tokens >= kTokenScale) {
+            if (state.retryTokens.compare_exchange_weak(tokens, tokens - kTokenScale, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    // base * multiplier^(attempts - 1), capped, with equal jitter so retries of one outage spread out
+    static Clock::duration backoff(const MicroFixRetryPolicy& policy, unsigned attempts) {
+        double delay = static_cast<double>(policy.baseDelay.count());
+        for (unsigned i = 1; i < attempts && delay < policy.maxDelay.count(); ++i) delay *= policy.multiplier;
+        delay = std::min(delay, static_cast<double>(policy.maxDelay.count()));
+        thread_local std::minstd_rand jitter(std::random_device{}());
+        delay = delay / 2 + std::uniform_real_distribution<double>(0.0, delay / 2)(jitter);
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(delay));
+    }
+
+    // The loop stores std::function, which must be copyable, so the task rides in a shared_ptr
+    void scheduleRetry(Task task, Clock::time_point when) {
+        pending.fetch_add(1, std::memory_order_acq_rel);
+        loop.postAt(when, [this, task = std::make_shared<Task>(std::move(task))] {
+            runRetry(std::move(*task));
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }, this);
+    }
+
+    void runRetry(Task task) {
+        KindState& state = kinds[task.kind];
+        ++task.attempts;
+        if (!admit(state)) {
+            shortCircuit(state, std::move(task));
+            return;
+        }
+        std::string reason;
+        if (runAction(*task.action, reason)) recordSuccess(state);
+        else recordFailure(state, std::move(task), reason);
+    }
+
+    MicroFixPolicyOutcome fail(Task task, std::string reason) {
+        MicroFixFailedDirective failed{task.kind, std::move(task.directive), task.attempts, std::move(reason)};
+        if (!failureQueue.tryPush(failed)) {
+            std::lock_guard<std::mutex> lock(overflowLock);
+            overflow.push_back(std::move(failed));
+        }
+        return MicroFixPolicyOutcome::Failed;
+    }
+};
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+struct MicroFixBranchStats {
+    std::string name;
+    bool sealed = false;
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    uint64_t diverted = 0;       // Tasks run on the fallback group (or inline, without one) after sealing
+    double tasksPerSecond = 0;   // Completed on the branch's own workers since it was added
+};
+
+// "Threads per rule-branch with fallback seals and error-locks": each guild rule branch
+// owns a pinned worker group and queue, so a slow branch only delays itself. A branch
+// that keeps failing is sealed and its work diverted to the shared fallback workers.
+class MicroFixGuildExecutor {
+public:
+    using BranchId = size_t;
+
+    explicit MicroFixGuildExecutor(size_t fallbackWorkers = 2, unsigned faultThreshold = 3)
+        : faultThreshold(faultThreshold) {
+        for (size_t i = 0; i < fallbackWorkers; ++i) fallbackThreads.emplace_back([this] { fallbackLoop(); });
+    }
+
+    // Queued work is finished, not dropped: the destructor drains before stopping the workers
+    ~MicroFixGuildExecutor() {
+        drain();
+        {
+            std::unique_lock<std::shared_mutex> lock(branchesLock);
+            for (auto& branch : branches) {
+                std::lock_guard<std::mutex> queueLock(branch->lock);
+                branch->stopping = true;
+                branch->ready.notify_all();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(fallbackLock);
+            fallbackStopping = true;
+        }
+        fallbackReady.notify_all();
+        for (auto& branch : branches) {
+            for (auto& worker : branch->workers) worker.join();
+        }
+        for (auto& worker : fallbackThreads) worker.join();
+    }
+
+    MicroFixGuildExecutor(const MicroFixGuildExecutor&) = delete;
+    MicroFixGuildExecutor& operator=(const MicroFixGuildExecutor&) = delete;
+
+    // cpus: CPU ids the branch's workers are pinned to (round-robin); empty spreads branches across the host
+    BranchId addBranch(std::string name, size_t workers = 1, std::vector<int> cpus = {}) {
+        if (workers == 0) throw std::invalid_argument("A rule branch needs at least one worker");  // Its queue would never drain
+        std::unique_lock<std::shared_mutex> lock(branchesLock);
+        BranchId id = branches.size();
+        branches.push_back(std::make_unique<Branch>(std::move(name)));
+        Branch& branch = *branches.back();
+        unsigned hostCpus = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t i = 0; i < workers; ++i) {
+            int cpu = cpus.empty() ? static_cast<int>((nextCpu++) % hostCpus) : cpus[i % cpus.size()];
+            branch.workers.emplace_back([this, &branch, cpu] {
+                pinToCpu(cpu);
+                branchLoop(branch);
+            });
+        }
+        return id;
+    }
+
+    void submit(BranchId id, std::function<void()> task) {
+        Branch& branch = branchAt(id);
+        branch.submitted.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(branch.lock);
+            if (!branch.sealed) {
+                branch.queue.push_back(std::move(task));
+                branch.ready.notify_one();
+                return;
+            }
+            inTransit.fetch_add(1, std::memory_order_relaxed);
+        }
+        divert(branch, std::move(task));
+    }
+
+    // Error-lock: stop feeding the branch and move its backlog to the fallback workers
+    void seal(BranchId id) { sealBranch(branchAt(id)); }
+
+    void unseal(BranchId id) {
+        Branch& branch = branchAt(id);
+        std::lock_guard<std::mutex> lock(branch.lock);
+        branch.sealed = false;
+        branch.consecutiveFailures = 0;
+    }
+
+    bool isSealed(BranchId id) {
+        Branch& branch = branchAt(id);
+        std::lock_guard<std::mutex> lock(branch.lock);
+        return branch.sealed;
+    }
+
+    std::vector<MicroFixBranchStats> report() {
+        std::shared_lock<std::shared_mutex> lock(branchesLock);
+        std::vector<MicroFixBranchStats> out;
+        auto now = std::chrono::steady_clock::now();
+        for (auto& branch : branches) {
+            MicroFixBranchStats stats;
+            stats.name = branch->name;
+            {
+                std::lock_guard<std::mutex> queueLock(branch->lock);
+                stats.sealed = branch->sealed;
+            }
+            stats.submitted = branch->submitted.load(std::memory_order_relaxed);
+            stats.completed = branch->completed.load(std::memory_order_relaxed);
+            stats.failed = branch->failed.load(std::memory_order_relaxed);
+            stats.diverted = branch->diverted.load(std::memory_order_relaxed);
+            double seconds = std::chrono::duration<double>(now - branch->started).count();
+            stats.tasksPerSecond = seconds > 0 ? stats.completed / seconds : 0;
+            out.push_back(std::move(stats));
+        }
+        return out;
+    }
+
+    // Blocks until every branch queue and the fallback queue are empty and idle, and no
+    // sealed branch's work is still on its way to the fallback queue
+    void drain() {
+        for (;;) {
+            bool idle = true;
+            {
+                std::shared_lock<std::shared_mutex> lock(branchesLock);
+                for (auto& branch : branches) {
+                    std::lock_guard<std::mutex> queueLock(branch->lock);
+                    idle = idle && branch->queue.empty() && branch->running == 0;
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(fallbackLock);
+                idle = idle && fallbackQueue.empty() && fallbackRunning == 0 && inTransit.load(std::memory_order_relaxed) == 0;
+            }
+            if (idle) return;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+private:
+    struct Branch {
+        explicit Branch(std::string name) : name(std::move(name)) {}
+        std::string name;
+        std::mutex lock;
+        std::condition_variable ready;
+        std::deque<std::function<void()>> queue;
+        std::vector<std::thread> workers;
+        size_t running = 0;
+        unsigned consecutiveFailures = 0;
+        bool sealed = false;
+        bool stopping = false;
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> completed{0};
+        std::atomic<uint64_t> failed{0};
+        std::atomic<uint64_t> diverted{0};
+        std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    };
+
+    struct FallbackTask {
+        Branch* origin;
+        std::function<void()> task;
+    };
+
+    unsigned faultThreshold;
+    std::shared_mutex branchesLock;
+    std::vector<std::unique_ptr<Branch>> branches;
+    size_t nextCpu = 0;
+
+    std::mutex fallbackLock;
+    std::condition_variable fallbackReady;
+    std::deque<FallbackTask> fallbackQueue;
+    std::vector<std::thread> fallbackThreads;
+    size_t fallbackRunning = 0;
+    bool fallbackStopping = false;
+    // Diverted tasks taken off a branch but not yet queued or run on the fallback side. Raised
+    // under the branch lock, lowered under fallbackLock, so drain() never sees the gap between.
+    std::atomic<size_t> inTransit{0};
+
+    Branch& branchAt(BranchId id) {
+        std::shared_lock<std::shared_mutex> lock(branchesLock);
+        if (id >= branches.size()) throw std::out_of_range("Unknown guild rule branch");
+        return *branches[id];
+    }
+
+    static void pinToCpu(int cpu) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);  // Best effort; unpinned on failure
+#else
+        (void)cpu;
+#endif
+    }
+
+    // The caller has counted the task in inTransit
+    void divert(Branch& origin, std::function<void()> task) {
+        origin.diverted.fetch_add(1, std::memory_order_relaxed);
+        if (fallbackThreads.empty()) {
+            // No fallback seal available: run it here rather than lose it
+            {
+                std::lock_guard<std::mutex> lock(fallbackLock);
+                inTransit.fetch_sub(1, std::memory_order_relaxed);
+                ++fallbackRunning;
+            }
+            if (!runGuarded(task)) origin.failed.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(fallbackLock);
+            --fallbackRunning;
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(fallbackLock);
+            fallbackQueue.push_back({&origin, std::move(task)});
+            inTransit.fetch_sub(1, std::memory_order_relaxed);
+        }
+        fallbackReady.notify_one();
+    }
+
+    void sealBranch(Branch& branch) {
+        std::deque<std::function<void()>> backlog;
+        {
+            std::lock_guard<std::mutex> lock(branch.lock);
+            if (branch.sealed) return;
+            branch.sealed = true;
+            backlog.swap(branch.queue);
+            inTransit.fetch_add(backlog.size(), std::memory_order_relaxed);
+        }
+        for (auto& task : backlog) divert(branch, std::move(task));
+    }
+
+    void branchLoop(Branch& branch) {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(branch.lock);
+                branch.ready.wait(lock, [&] { return branch.stopping || !branch.queue.empty(); });
+                if (branch.stopping) return;
+                task = std::move(branch.queue.front());
+                branch.queue.pop_front();
+                ++branch.running;
+            }
+            bool ok = runGuarded(task);
+            bool shouldSeal = false;
+            {
+                std::lock_guard<std::mutex> lock(branch.lock);
+                --branch.running;
+                branch.consecutiveFailures = ok ? 0 : branch.consecutiveFailures + 1;
+                shouldSeal = !ok && branch.consecutiveFailures >= faultThreshold;
+            }
+            (ok ? branch.completed : branch.failed).fetch_add(1, std::memory_order_relaxed);
+            if (shouldSeal) sealBranch(branch);
+        }
+    }
+
+    void fallbackLoop() {
+        for (;;) {
+            FallbackTask item;
+            {
+                std::unique_lock<std::mutex> lock(fallbackLock);
+                fallbackReady.wait(lock, [&] { return fallbackStopping || !fallbackQueue.empty(); });
+                if (fallbackQueue.empty()) return;
+                item = std::move(fallbackQueue.front());
+                fallbackQueue.pop_front();
+                ++fallbackRunning;
+            }
+            if (!runGuarded(item.task)) item.origin->failed.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(fallbackLock);
+            --fallbackRunning;
+        }
+    }
+
+    static bool runGuarded(std::function<void()>& task) {
+        try {
+            task();
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+};
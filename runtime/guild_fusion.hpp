@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "guild_sync.hpp"
+#include "worker_pool.hpp"
+
+// One guild's rule set as input to fusion; source order is the tie-break order
+struct MicroFixRuleSource {
+    std::string guild;
+    const MicroFixGuildRuleSet* rules;
+};
+
+struct MicroFixRuleProposal {
+    size_t source;       // Index into the fused sources
+    std::string value;
+};
+
+// A key written with different values by two or more guilds, proposals in source order
+struct MicroFixRuleConflict {
+    std::string key;
+    std::vector<MicroFixRuleProposal> proposals;
+    std::optional<std::string> resolved;   // Policy outcome; nullopt drops the rule
+};
+
+// Called concurrently from partition workers, so it must not touch shared mutable state.
+// guilds maps proposal.source to the guild name.
+using MicroFixConflictPolicy =
+    std::function<std::optional<std::string>(const MicroFixRuleConflict&, const std::vector<std::string>& guilds)>;
+
+struct MicroFixConflictPolicies {
+    // Earliest guild in order wins; guilds missing from order rank after it, by source index
+    static MicroFixConflictPolicy priority(std::vector<std::string> order) {
+        return [order = std::move(order)](const MicroFixRuleConflict& conflict, const std::vector<std::string>& guilds) {
+            auto rank = [&](size_t source) {
+                auto it = std::find(order.begin(), order.end(), guilds[source]);
+                return std::make_pair(static_cast<size_t>(it - order.begin()), source);
+            };
+            const MicroFixRuleProposal* best = &conflict.proposals.front();
+            for (const auto& proposal : conflict.proposals) {
+                if (rank(proposal.source) < rank(best->source)) best = &proposal;
+            }
+            return std::optional<std::string>(best->value);
+        };
+    }
+
+    static MicroFixConflictPolicy lastSource() {
+        return [](const MicroFixRuleConflict& conflict, const std::vector<std::string>&) {
+            return std::optional<std::string>(conflict.proposals.back().value);
+        };
+    }
+
+    // Most proposed value wins; ties go to the value proposed by the earliest source
+    static MicroFixConflictPolicy majority() {
+        return [](const MicroFixRuleConflict& conflict, const std::vector<std::string>&) {
+            std::map<std::string_view, std::pair<size_t, size_t>> votes;  // value -> (count, first source)
+            for (const auto& proposal : conflict.proposals) {
+                auto [it, inserted] = votes.try_emplace(proposal.value, 0, proposal.source);
+                ++it->second.first;
+            }
+            auto best = votes.begin();
+            for (auto it = votes.begin(); it != votes.end(); ++it) {
+                if (it->second.first > best->second.first ||
+                    (it->second.first == best->second.first && it->second.second < best->second.second)) {
+                    best = it;
+                }
+            }
+            return std::optional<std::string>(std::string(best->first));
+        };
+    }
+
+    static MicroFixConflictPolicy reject() {
+        return [](const MicroFixRuleConflict& conflict, const std::vector<std::string>&) -> std::optional<std::string> {
+            throw std::runtime_error("Conflicting guild rule: " + conflict.key);
+        };
+    }
+};
+
+struct MicroFixFusionResult {
+    MicroFixGuildRuleSet rules;                  // Unpublished; version is assigned by MicroFixGuildSync::publish
+    std::vector<MicroFixRuleConflict> conflicts; // Sorted by key
+};
+
+// Parallel GuildRule Fusion: keys are hashed into partitions, each partition is merged
+// independently on the worker pool, and conflicts are resolved by a pluggable policy.
+// Proposals are always gathered in source order, so the result does not depend on
+// scheduling or on how many threads ran.
+class MicroFixGuildRuleFusion {
+public:
+    // partitions == 0 picks a few per pool slot so uneven partitions still balance
+    explicit MicroFixGuildRuleFusion(MicroFixWorkerPool& pool,
+                                     MicroFixConflictPolicy policy = MicroFixConflictPolicies::majority(),
+                                     size_t partitions = 0)
+        : pool(pool), policy(std::move(policy)), partitions(partitions ? partitions : pool.slotCount() * 4) {}
+
+    MicroFixFusionResult fuse(const std::vector<MicroFixRuleSource>& sources) {
+        std::vector<std::string> guilds;
+        for (const auto& source : sources) guilds.push_back(source.guild);
+
+        // Scatter: each source buckets its keys by partition, without copying any strings
+        std::vector<std::vector<std::vector<Write>>> buckets(sources.size(), std::vector<std::vector<Write>>(partitions));
+        pool.parallelFor(sources.size(), [&](size_t source, size_t) {
+            auto& out = buckets[source];
+            for (const auto& [key, value] : sources[source].rules->rules) {
+                out[partitionOf(key)].push_back({&key, &value});
+            }
+        });
+
+        // Merge: one partition per chunk, visiting sources in order
+        std::vector<Partition> merged(partitions);
+        std::vector<std::exception_ptr> failures(partitions);
+        pool.parallelFor(partitions, [&](size_t partition, size_t) {
+            try {
+                mergePartition(merged[partition], buckets, partition, guilds);
+            } catch (...) {
+                failures[partition] = std::current_exception();  // Policy threw (e.g. reject); rethrown below
+            }
+        });
+        for (auto& failure : failures) {
+            if (failure) std::rethrow_exception(failure);
+        }
+
+        MicroFixFusionResult result;
+        result.rules.guilds = std::move(guilds);
+        size_t total = 0;
+        for (const auto& partition : merged) total += partition.rules.size();
+        result.rules.rules.reserve(total);
+        for (auto& partition : merged) {
+            for (auto& [key, value] : partition.rules) result.rules.rules.emplace(std::move(key), std::move(value));
+            for (auto& conflict : partition.conflicts) result.conflicts.push_back(std::move(conflict));
+        }
+        std::sort(result.conflicts.begin(), result.conflicts.end(),
+                  [](const MicroFixRuleConflict& a, const MicroFixRuleConflict& b) { return a.key < b.key; });
+        return result;
+    }
+
+    size_t partitionCount() const { return partitions; }
+
+private:
+    struct Write {
+        const std::string* key;
+        const std::string* value;
+    };
+
+    struct Entry {
+        size_t firstSource;
+        const std::string* firstValue;
+        std::vector<std::pair<size_t, const std::string*>> later;  // Only for keys written by several guilds
+    };
+
+    struct Partition {
+        std::vector<std::pair<std::string, std::string>> rules;
+        std::vector<MicroFixRuleConflict> conflicts;
+    };
+
+    MicroFixWorkerPool& pool;
+    MicroFixConflictPolicy policy;
+    size_t partitions;
+
+    size_t partitionOf(const std::string& key) const { return std::hash<std::string_view>{}(key) % partitions; }
+
+    void mergePartition(Partition& out, const std::vector<std::vector<std::vector<Write>>>& buckets, size_t partition,
+                        const std::vector<std::string>& guilds) const {
+        std::unordered_map<std::string_view, Entry> entries;
+        for (size_t source = 0; source < buckets.size(); ++source) {
+            for (const Write& write : buckets[source][partition]) {
+                auto [it, inserted] = entries.try_emplace(*write.key, Entry{source, write.value, {}});
+                if (!inserted) it->second.later.emplace_back(source, write.value);
+            }
+        }
+
+        out.rules.reserve(entries.size());
+        for (auto& [key, entry] : entries) {
+            bool agreed = std::all_of(entry.later.begin(), entry.later.end(),
+                                      [&](const auto& proposal) { return *proposal.second == *entry.firstValue; });
+            if (agreed) {
+                out.rules.emplace_back(std::string(key), *entry.firstValue);
+                continue;
+            }
+            MicroFixRuleConflict conflict;
+            conflict.key = std::string(key);
+            conflict.proposals.push_back({entry.firstSource, *entry.firstValue});
+            for (const auto& [source, value] : entry.later) conflict.proposals.push_back({source, *value});
+            conflict.resolved = policy(conflict, guilds);
+            if (conflict.resolved) out.rules.emplace_back(conflict.key, *conflict.resolved);
+            out.conflicts.push_back(std::move(conflict));
+        }
+    }
+};
@@ -0,0 +1,229 @@
+#pragma once
+
+#ifndef __linux__
+#error "guild_shm.hpp requires Linux (memfd/shm_open + futex)"
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "guild_state.hpp"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+enum MicroFixShmKind : uint32_t { kShmGuildDirective = 1, kShmGuildStateDelta = 2 };
+
+// One directive slot in shared memory; producers write it in place, consumers read it in place
+struct MicroFixShmDirective {
+    static constexpr size_t kPayloadBytes = 240;
+
+    uint32_t guildId = 0;
+    uint32_t kind = 0;        // MicroFixShmKind
+    uint32_t length = 0;
+    uint32_t sequence = 0;
+    char payload[kPayloadBytes];
+};
+static_assert(sizeof(MicroFixShmDirective) == 256);
+
+// Single-producer/single-consumer ring that lives entirely inside a shared mapping.
+// Idle sides sleep on a futex over the ring index instead of polling a socket.
+class MicroFixShmChannel {
+public:
+    static constexpr uint32_t kSlots = 1024;
+
+    // Producer: slot to fill in place, or nullptr when the ring is full and wait is false
+    MicroFixShmDirective* claim(bool wait = true) {
+        uint32_t tail = tailIndex.load(std::memory_order_relaxed);
+        for (;;) {
+            uint32_t head = headIndex.load(std::memory_order_acquire);
+            if (tail - head < kSlots) return &slots[tail % kSlots];
+            if (!wait) return nullptr;
+            block(headIndex, head, spaceWaiters);
+        }
+    }
+
+    // Producer: publishes the slot returned by claim()
+    void commit() {
+        tailIndex.store(tailIndex.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+        if (dataWaiters.load(std::memory_order_seq_cst)) wake(tailIndex);
+    }
+
+    bool send(uint32_t guildId, uint32_t kind, const void* data, size_t length, bool wait = true) {
+        if (length > MicroFixShmDirective::kPayloadBytes) throw std::length_error("Guild directive exceeds shm slot");
+        MicroFixShmDirective* slot = claim(wait);
+        if (!slot) return false;
+        slot->guildId = guildId;
+        slot->kind = kind;
+        slot->length = static_cast<uint32_t>(length);
+        slot->sequence = tailIndex.load(std::memory_order_relaxed);
+        std::memcpy(slot->payload, data, length);
+        commit();
+        return true;
+    }
+
+    // Consumer: next published slot, valid until release(); nullptr when empty and wait is false
+    const MicroFixShmDirective* peek(bool wait = true) {
+        uint32_t head = headIndex.load(std::memory_order_relaxed);
+        for (;;) {
+            uint32_t tail = tailIndex.load(std::memory_order_acquire);
+            if (tail != head) return &slots[head % kSlots];
+            if (!wait) return nullptr;
+            block(tailIndex, tail, dataWaiters);
+        }
+    }
+
+    // guild_state delta written straight into the slot: versions, entry count, then the varint payload
+    bool sendStateDelta(uint32_t guildId, const MicroFixGuildStateDelta& delta, bool wait = true) {
+        constexpr size_t header = sizeof(delta.baseVersion) + sizeof(delta.version) + sizeof(delta.entries);
+        if (header + delta.payload.size() > MicroFixShmDirective::kPayloadBytes) {
+            throw std::length_error("Guild state delta exceeds shm slot; resync with a snapshot");
+        }
+        MicroFixShmDirective* slot = claim(wait);
+        if (!slot) return false;
+        slot->guildId = guildId;
+        slot->kind = kShmGuildStateDelta;
+        slot->length = static_cast<uint32_t>(header + delta.payload.size());
+        slot->sequence = tailIndex.load(std::memory_order_relaxed);
+        char* out = slot->payload;
+        std::memcpy(out, &delta.baseVersion, sizeof(delta.baseVersion));
+        std::memcpy(out + 8, &delta.version, sizeof(delta.version));
+        std::memcpy(out + 16, &delta.entries, sizeof(delta.entries));
+        if (!delta.payload.empty()) std::memcpy(out + header, delta.payload.data(), delta.payload.size());
+        commit();
+        return true;
+    }
+
+    // The slot is written by the other process, so its length is read once and checked before use
+    static MicroFixGuildStateDelta decodeStateDelta(const MicroFixShmDirective& slot) {
+        MicroFixGuildStateDelta delta;
+        constexpr size_t header = sizeof(delta.baseVersion) + sizeof(delta.version) + sizeof(delta.entries);
+        size_t length = slot.length;
+        if (slot.kind != kShmGuildStateDelta || length < header) throw std::invalid_argument("Not a guild state delta");
+        if (length > MicroFixShmDirective::kPayloadBytes) throw std::length_error("Guild state delta overruns its shm slot");
+        std::memcpy(&delta.baseVersion, slot.payload, sizeof(delta.baseVersion));
+        std::memcpy(&delta.version, slot.payload + 8, sizeof(delta.version));
+        std::memcpy(&delta.entries, slot.payload + 16, sizeof(delta.entries));
+        // Each entry is at least two one-byte varints
+        if (delta.entries > (length - header) / 2) throw std::invalid_argument("Guild state delta entry count exceeds its payload");
+        delta.payload.assign(slot.payload + header, slot.payload + length);
+        return delta;
+    }
+
+    void release() {
+        headIndex.store(headIndex.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+        if (spaceWaiters.load(std::memory_order_seq_cst)) wake(headIndex);
+    }
+
+private:
+    static constexpr int kSpinsBeforeSleep = 2000;
+
+    alignas(64) std::atomic<uint32_t> headIndex{0};
+    std::atomic<uint32_t> spaceWaiters{0};
+    alignas(64) std::atomic<uint32_t> tailIndex{0};
+    std::atomic<uint32_t> dataWaiters{0};
+    alignas(64) MicroFixShmDirective slots[kSlots];
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex words must be plain 32-bit integers");
+
+    // Spins briefly, then sleeps until word moves off observed (shared, not FUTEX_PRIVATE)
+    static void block(std::atomic<uint32_t>& word, uint32_t observed, std::atomic<uint32_t>& waiters) {
+        for (int i = 0; i < kSpinsBeforeSleep; ++i) {
+            if (word.load(std::memory_order_acquire) != observed) return;
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (word.load(std::memory_order_seq_cst) == observed) {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, observed, nullptr, nullptr, 0);
+        }
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    static void wake(std::atomic<uint32_t>& word) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+};
+
+// Bidirectional link between two guild processes: one channel each way in a single mapping.
+// Create with a shm_open name for unrelated processes, or anonymously (memfd) before fork().
+class MicroFixShmGuildLink {
+public:
+    enum class Side { Creator, Peer };
+
+    static MicroFixShmGuildLink createAnonymous(const char* debugName = "microfix-guild") {
+        int fd = static_cast<int>(syscall(SYS_memfd_create, debugName, 0));
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "memfd_create");
+        return MicroFixShmGuildLink(fd, true, Side::Creator, {});
+    }
+
+    static MicroFixShmGuildLink create(const std::string& name) {
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+        return MicroFixShmGuildLink(fd, true, Side::Creator, name);
+    }
+
+    static MicroFixShmGuildLink open(const std::string& name) {
+        int fd = shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+        return MicroFixShmGuildLink(fd, false, Side::Peer, {});
+    }
+
+    MicroFixShmGuildLink(MicroFixShmGuildLink&& other) noexcept
+        : fd(other.fd), region(other.region), side(other.side), ownedName(std::move(other.ownedName)) {
+        other.fd = -1;
+        other.region = nullptr;
+        other.ownedName.clear();
+    }
+
+    ~MicroFixShmGuildLink() {
+        if (region) munmap(region, sizeof(Region));
+        if (fd >= 0) close(fd);
+        if (!ownedName.empty()) shm_unlink(ownedName.c_str());
+    }
+
+    // After fork() the child calls this on its copy so it sends on the other channel
+    void becomePeer() { side = Side::Peer; }
+
+    MicroFixShmChannel& outbound() { return side == Side::Creator ? region->toPeer : region->toCreator; }
+    MicroFixShmChannel& inbound() { return side == Side::Creator ? region->toCreator : region->toPeer; }
+
+private:
+    struct Region {
+        MicroFixShmChannel toPeer;
+        MicroFixShmChannel toCreator;
+    };
+
+    int fd = -1;
+    Region* region = nullptr;
+    Side side;
+    std::string ownedName;  // shm_open name unlinked by the creator
+
+    MicroFixShmGuildLink(int fd, bool initialize, Side side, std::string name)
+        : fd(fd), side(side), ownedName(std::move(name)) {
+        if (initialize && ftruncate(fd, sizeof(Region)) != 0) fail("ftruncate");
+        void* mapped = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) fail("mmap");
+        region = static_cast<Region*>(mapped);
+        if (initialize) new (region) Region();  // Fresh mapping is zero-filled; this just starts the objects' lifetimes
+    }
+
+    [[noreturn]] void fail(const char* what) {
+        int err = errno;
+        close(fd);
+        if (!ownedName.empty()) shm_unlink(ownedName.c_str());
+        throw std::system_error(err, std::generic_category(), what);
+    }
+};
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "event_loop.hpp"
+
+// Changed entries since the replica's baseVersion, varint-encoded as (index gap, value) pairs
+struct MicroFixGuildStateDelta {
+    uint64_t baseVersion = 0;
+    uint64_t version = 0;
+    uint32_t entries = 0;
+    std::vector<uint8_t> payload;
+
+    size_t wireBytes() const { return sizeof(baseVersion) + sizeof(version) + sizeof(entries) + payload.size(); }
+};
+
+// Guild state vector owned by one guild worker. Writes mark entries dirty; sync() emits a
+// delta only when the batch is inside proof_sync_range (at least lo proofs, at most hi)
+// or the sync window has run out, so replicas see a handful of small deltas instead of
+// one full state per proof. set() only checks on writes; syncOnTimer() lets the owner's
+// event loop poll while changes are pending, so a guild that goes quiet still ships them.
+class MicroFixGuildStateVector {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Publish = std::function<void(MicroFixGuildStateDelta)>;
+
+    MicroFixGuildStateVector(size_t entries, std::pair<int, int> proofSyncRange = {0xA, 0xF},
+                             std::chrono::milliseconds window = std::chrono::milliseconds(10))
+        : state(entries, 0), synced(entries, 0), dirty((entries + 63) / 64, 0),
+          syncLo(static_cast<size_t>(proofSyncRange.first)), syncHi(static_cast<size_t>(proofSyncRange.second)),
+          window(window), windowStart(Clock::now()) {
+        if (syncLo == 0 || syncLo > syncHi) throw std::invalid_argument("proof_sync_range must satisfy 0 < lo <= hi");
+    }
+
+    ~MicroFixGuildStateVector() {
+        if (syncLoop) syncLoop->cancel(this);
+    }
+
+    MicroFixGuildStateVector(const MicroFixGuildStateVector&) = delete;
+    MicroFixGuildStateVector& operator=(const MicroFixGuildStateVector&) = delete;
+
+    // Polls sync() on loop every half window while proofs are pending and hands each due
+    // delta to publish. From then on, touch the vector only on the loop thread.
+    void syncOnTimer(MicroFixEventLoop& loop, Publish publish) {
+        if (syncLoop) syncLoop->cancel(this);
+        syncLoop = &loop;
+        publishDelta = std::move(publish);
+        timerArmed = false;
+        armSyncTimer();
+    }
+
+    size_t size() const { return state.size(); }
+    uint32_t get(size_t index) const { return state.at(index); }
+
+    // Records one proof outcome; returns a delta when this proof completes a batch. Under
+    // syncOnTimer the delta goes to publish instead and nullopt is returned.
+    std::optional<MicroFixGuildStateDelta> set(size_t index, uint32_t value, Clock::time_point now = Clock::now()) {
+        state.at(index) = value;
+        dirty[index / 64] |= uint64_t(1) << (index % 64);
+        ++pendingProofs;
+        std::optional<MicroFixGuildStateDelta> delta = sync(now);
+        if (syncLoop) {
+            if (delta) publishDelta(std::move(*delta));
+            armSyncTimer();
+            return std::nullopt;
+        }
+        return delta;
+    }
+
+    // Flushes when hi proofs are pending, or the window has elapsed with at least lo pending,
+    // or the window has elapsed twice (bounding staleness on quiet guilds)
+    std::optional<MicroFixGuildStateDelta> sync(Clock::time_point now = Clock::now()) {
+        if (pendingProofs == 0) return std::nullopt;
+        auto age = now - windowStart;
+        bool due = pendingProofs >= syncHi || (age >= window && pendingProofs >= syncLo) || age >= 2 * window;
+        if (!due) return std::nullopt;
+        MicroFixGuildStateDelta delta = flush(now);
+        if (delta.entries == 0) return std::nullopt;
+        return delta;
+    }
+
+    MicroFixGuildStateDelta flush(Clock::time_point now = Clock::now()) {
+        MicroFixGuildStateDelta delta;
+        delta.baseVersion = version;
+        size_t previous = 0;
+        for (size_t word = 0; word < dirty.size(); ++word) {
+            uint64_t bits = dirty[word];
+            dirty[word] = 0;
+            while (bits) {
+                size_t index = word * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                if (state[index] == synced[index]) continue;  // Flipped back within the batch
+                putVarint(delta.payload, index - previous);
+                putVarint(delta.payload, state[index]);
+                synced[index] = state[index];
+                previous = index;
+                ++delta.entries;
+            }
+        }
+        if (delta.entries > 0) ++version;
+        delta.version = version;
+        pendingProofs = 0;
+        windowStart = now;
+        bytesSent += delta.wireBytes();
+        fullBytes += state.size() * sizeof(uint32_t);
+        return delta;
+    }
+
+    uint64_t currentVersion() const { return version; }
+    const std::vector<uint32_t>& snapshot() const { return synced; }
+
+    // Traffic actually sent vs. what shipping the full vector per flush would cost
+    uint64_t deltaBytesSent() const { return bytesSent; }
+    uint64_t fullStateBytes() const { return fullBytes; }
+
+    static void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint64_t getVarint(const std::vector<uint8_t>& in, size_t& pos) {
+        uint64_t value = 0;
+        for (unsigned shift = 0; pos < in.size(); shift += 7) {
+            if (shift >= 64) throw std::runtime_error("Overlong varint in guild state delta");
+            uint8_t byte = in[pos++];
+            value |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        throw std::runtime_error("Truncated guild state delta");
+    }
+
+private:
+    std::vector<uint32_t> state;
+    std::vector<uint32_t> synced;   // Last values shipped to replicas
+    std::vector<uint64_t> dirty;
+    size_t syncLo;
+    size_t syncHi;
+    std::chrono::milliseconds window;
+    Clock::time_point windowStart;
+    size_t pendingProofs = 0;
+    uint64_t version = 0;
+    uint64_t bytesSent = 0;
+    uint64_t fullBytes = 0;
+    MicroFixEventLoop* syncLoop = nullptr;
+    Publish publishDelta;
+    bool timerArmed = false;
+
+    // Only armed while something is pending, so an idle guild leaves the loop idle too
+    void armSyncTimer() {
+        if (!syncLoop || timerArmed || pendingProofs == 0) return;
+        timerArmed = true;
+        syncLoop->postAfter(window / 2, [this] {
+            timerArmed = false;
+            if (auto delta = sync()) publishDelta(std::move(*delta));
+            armSyncTimer();
+        }, this);
+    }
+};
+
+// Read side on another guild worker: applies deltas in version order
+class MicroFixGuildStateReplica {
+public:
+    explicit MicroFixGuildStateReplica(size_t entries) : state(entries, 0) {}
+
+    // Returns false when the delta does not follow this replica's version (resync with a snapshot).
+    // A malformed delta throws before any entry is written, so the replica keeps its old version.
+    bool apply(const MicroFixGuildStateDelta& delta) {
+        if (delta.baseVersion != version) return false;
+        std::vector<std::pair<size_t, uint32_t>> changes;
+        changes.reserve(std::min<size_t>(delta.entries, delta.payload.size() / 2));
+        size_t pos = 0;
+        size_t index = 0;
+        for (uint32_t i = 0; i < delta.entries; ++i) {
+            uint64_t gap = MicroFixGuildStateVector::getVarint(delta.payload, pos);
+            uint64_t value = MicroFixGuildStateVector::getVarint(delta.payload, pos);
+            if (gap >= state.size() - index || (i > 0 && gap == 0)) throw std::out_of_range("Guild state delta index out of range");
+            if (value > UINT32_MAX) throw std::out_of_range("Guild state delta value out of range");
+            index += gap;
+            changes.emplace_back(index, static_cast<uint32_t>(value));
+        }
+        if (pos != delta.payload.size()) throw std::runtime_error("Trailing bytes in guild state delta");
+        for (auto& [at, value] : changes) state[at] = value;
+        version = delta.version;
+        return true;
+    }
+
+    void resync(const std::vector<uint32_t>& snapshot, uint64_t snapshotVersion) {
+        state = snapshot;
+        version = snapshotVersion;
+    }
+
+    uint32_t get(size_t index) const { return state.at(index); }
+    uint64_t currentVersion() const { return version; }
+
+private:
+    std::vector<uint32_t> state;
+    uint64_t version = 0;
+};
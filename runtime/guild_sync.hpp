@@ -0,0 +1,207 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Epoch-based reclamation: readers announce the epoch they entered in, and a retired
+// object is freed once every announced epoch is newer than the one it was retired in.
+class MicroFixEpochDomain {
+public:
+    static constexpr size_t kMaxReaders = 1024;
+    static constexpr uint64_t kIdle = std::numeric_limits<uint64_t>::max();
+
+    static MicroFixEpochDomain& global() {
+        static MicroFixEpochDomain domain;
+        return domain;
+    }
+
+    void enter() {
+        ThreadState& state = threadState();
+        if (state.depth++ == 0) {
+            slots[state.slot].epoch.store(epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+    }
+
+    void exit() {
+        ThreadState& state = threadState();
+        if (--state.depth == 0) slots[state.slot].epoch.store(kIdle, std::memory_order_release);
+    }
+
+    // Caller has already unlinked ptr from every shared location
+    void retire(std::function<void()> deleter) {
+        std::lock_guard<std::mutex> lock(retireLock);
+        retired.push_back({epoch.fetch_add(1, std::memory_order_seq_cst), std::move(deleter)});
+        collectLocked();
+    }
+
+    void collect() {
+        std::lock_guard<std::mutex> lock(retireLock);
+        collectLocked();
+    }
+
+    size_t pendingRetired() {
+        std::lock_guard<std::mutex> lock(retireLock);
+        return retired.size();
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{kIdle};
+        std::atomic<bool> claimed{false};
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        std::function<void()> deleter;
+    };
+
+    struct ThreadState {
+        MicroFixEpochDomain* domain;
+        size_t slot;
+        unsigned depth = 0;
+        ~ThreadState() { domain->slots[slot].claimed.store(false, std::memory_order_release); }
+    };
+
+    std::atomic<uint64_t> epoch{1};
+    std::array<Slot, kMaxReaders> slots;
+    std::mutex retireLock;
+    std::vector<Retired> retired;
+
+    MicroFixEpochDomain() = default;
+
+    ~MicroFixEpochDomain() {
+        for (auto& item : retired) item.deleter();
+    }
+
+    ThreadState& threadState() {
+        thread_local ThreadState state{this, claimSlot()};
+        return state;
+    }
+
+    size_t claimSlot() {
+        for (size_t i = 0; i < kMaxReaders; ++i) {
+            bool expected = false;
+            if (slots[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return i;
+        }
+        throw std::runtime_error("MicroFixEpochDomain reader slots exhausted");
+    }
+
+    void collectLocked() {
+        uint64_t oldestReader = kIdle;
+        for (auto& slot : slots) oldestReader = std::min(oldestReader, slot.epoch.load(std::memory_order_seq_cst));
+        size_t kept = 0;
+        for (auto& item : retired) {
+            if (item.epoch < oldestReader) item.deleter();
+            else retired[kept++] = std::move(item);
+        }
+        retired.resize(kept);
+    }
+};
+
+// One published version of the guild rule set; immutable once published
+struct MicroFixGuildRuleSet {
+    uint64_t version = 0;
+    std::vector<std::string> guilds;
+    std::unordered_map<std::string, std::string> rules;
+
+    const std::string* rule(const std::string& key) const {
+        auto it = rules.find(key);
+        return it == rules.end() ? nullptr : &it->second;
+    }
+};
+
+// GuildSync Protocol: writers swap in a new rule set version, guild members read
+// the current one without locks and old versions are reclaimed by epoch.
+class MicroFixGuildSync {
+public:
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const MicroFixGuildSync& sync) : domain(MicroFixEpochDomain::global()) {
+            domain.enter();
+            rules = sync.current.load(std::memory_order_seq_cst);
+        }
+        ~ReadGuard() { domain.exit(); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const MicroFixGuildRuleSet& operator*() const { return *rules; }
+        const MicroFixGuildRuleSet* operator->() const { return rules; }
+
+    private:
+        MicroFixEpochDomain& domain;
+        const MicroFixGuildRuleSet* rules;
+    };
+
+    MicroFixGuildSync() : current(new MicroFixGuildRuleSet()) {}
+
+    ~MicroFixGuildSync() { delete current.load(); }
+
+    MicroFixGuildSync(const MicroFixGuildSync&) = delete;
+    MicroFixGuildSync& operator=(const MicroFixGuildSync&) = delete;
+
+    // Publishes next as the new version and returns its version number
+    uint64_t publish(MicroFixGuildRuleSet next) {
+        std::lock_guard<std::mutex> lock(writerLock);
+        const MicroFixGuildRuleSet* previous = current.load(std::memory_order_relaxed);
+        next.version = previous->version + 1;
+        uint64_t version = next.version;
+        current.store(new MicroFixGuildRuleSet(std::move(next)), std::memory_order_seq_cst);
+        MicroFixEpochDomain::global().retire([previous] { delete previous; });
+        return version;
+    }
+
+    // Copy-modify-publish for single rule edits
+    uint64_t update(const std::function<void(MicroFixGuildRuleSet&)>& edit) {
+        std::lock_guard<std::mutex> lock(updateLock);
+        MicroFixGuildRuleSet next;
+        {
+            ReadGuard rules(*this);
+            next = *rules;
+        }
+        edit(next);
+        return publish(std::move(next));
+    }
+
+    uint64_t version() const {
+        ReadGuard rules(*this);
+        return rules->version;
+    }
+
+private:
+    std::atomic<const MicroFixGuildRuleSet*> current;
+    std::mutex writerLock;
+    std::mutex updateLock;  // Serializes read-modify-write edits so none are lost
+};
+
+// A guild attached to the sync: notices new rule versions on its next read
+class MicroFixGuildMember {
+public:
+    MicroFixGuildMember(std::string name, const MicroFixGuildSync& sync) : name(std::move(name)), sync(sync) {}
+
+    // Evaluates fn against the current rules; returns true if the version changed since the last call
+    bool evaluate(const std::function<void(const MicroFixGuildRuleSet&)>& fn) {
+        MicroFixGuildSync::ReadGuard rules(sync);
+        bool updated = rules->version != seenVersion;
+        seenVersion = rules->version;
+        fn(*rules);
+        return updated;
+    }
+
+    const std::string& guildName() const { return name; }
+    uint64_t lastSeenVersion() const { return seenVersion; }
+
+private:
+    std::string name;
+    const MicroFixGuildSync& sync;
+    uint64_t seenVersion = 0;
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Arbitrary-precision unsigned integer for FHex values past the 64-bit table
+class MicroFixBigUInt {
+public:
+    std::vector<uint32_t> limbs;  // Little-endian base 2^32, no trailing zero limbs
+
+    MicroFixBigUInt() = default;
+    MicroFixBigUInt(uint64_t value) {
+        while (value != 0) {
+            limbs.push_back(static_cast<uint32_t>(value));
+            value >>= 32;
+        }
+    }
+
+    bool isZero() const { return limbs.empty(); }
+
+    bool fitsU64() const { return limbs.size() <= 2; }
+
+    uint64_t toU64() const {
+        if (!fitsU64()) throw std::overflow_error("MicroFixBigUInt exceeds 64 bits");
+        uint64_t value = 0;
+        for (size_t i = limbs.size(); i-- > 0;) value = (value << 32) | limbs[i];
+        return value;
+    }
+
+    std::string toHex() const {
+        if (limbs.empty()) return "0x0";
+        static const char* digits = "0123456789ABCDEF";
+        std::string out;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            for (int shift = 28; shift >= 0; shift -= 4) {
+                char digit = digits[(limbs[i] >> shift) & 0xF];
+                if (out.empty() && digit == '0') continue;
+                out.push_back(digit);
+            }
+        }
+        return "0x" + out;
+    }
+
+    friend bool operator==(const MicroFixBigUInt& a, const MicroFixBigUInt& b) { return a.limbs == b.limbs; }
+
+    friend MicroFixBigUInt operator+(const MicroFixBigUInt& a, const MicroFixBigUInt& b) {
+        const MicroFixBigUInt& longer = a.limbs.size() >= b.limbs.size() ? a : b;
+        const MicroFixBigUInt& shorter = a.limbs.size() >= b.limbs.size() ? b : a;
+        MicroFixBigUInt result;
+        result.limbs.resize(longer.limbs.size() + 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < longer.limbs.size(); ++i) {
+            uint64_t sum = carry + longer.limbs[i] + (i < shorter.limbs.size() ? shorter.limbs[i] : 0);
+            result.limbs[i] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+        result.limbs.back() = static_cast<uint32_t>(carry);
+        result.trim();
+        return result;
+    }
+
+    // Requires a >= b; Fibonacci doubling never subtracts past zero
+    friend MicroFixBigUInt operator-(const MicroFixBigUInt& a, const MicroFixBigUInt& b) {
+        MicroFixBigUInt result;
+        result.limbs.resize(a.limbs.size());
+        int64_t borrow = 0;
+        for (size_t i = 0; i < a.limbs.size(); ++i) {
+            int64_t diff = static_cast<int64_t>(a.limbs[i]) - borrow - (i < b.limbs.size() ? b.limbs[i] : 0);
+            borrow = diff < 0 ? 1 : 0;
+            result.limbs[i] = static_cast<uint32_t>(diff + (borrow << 32));
+        }
+        if (borrow != 0) throw std::underflow_error("MicroFixBigUInt subtraction underflow");
+        result.trim();
+        return result;
+    }
+
+    friend MicroFixBigUInt operator*(const MicroFixBigUInt& a, const MicroFixBigUInt& b) {
+        if (a.isZero() || b.isZero()) return {};
+        MicroFixBigUInt result;
+        result.limbs.assign(a.limbs.size() + b.limbs.size(), 0);
+        for (size_t i = 0; i < a.limbs.size(); ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b.limbs.size(); ++j) {
+                uint64_t cur = result.limbs[i + j] + carry + static_cast<uint64_t>(a.limbs[i]) * b.limbs[j];
+                result.limbs[i + j] = static_cast<uint32_t>(cur);
+                carry = cur >> 32;
+            }
+            result.limbs[i + b.limbs.size()] = static_cast<uint32_t>(carry);
+        }
+        result.trim();
+        return result;
+    }
+
+private:
+    void trim() {
+        while (!limbs.empty() && limbs.back() == 0) limbs.pop_back();
+    }
+};
+
+// FHex runtime: Fibonacci-hex values without rebuilding the sequence per call
+class MicroFixHexLib {
+public:
+    // F(93) is the last Fibonacci number that fits in 64 bits
+    static constexpr unsigned kTableSize = 94;
+
+    static constexpr std::array<uint64_t, kTableSize> kTable = [] {
+        std::array<uint64_t, kTableSize> table{};
+        table[1] = 1;
+        for (unsigned i = 2; i < kTableSize; ++i) table[i] = table[i - 1] + table[i - 2];
+        return table;
+    }();
+
+    // FHex(n) for n < 94, O(1)
+    static constexpr uint64_t fhex(unsigned n) {
+        if (n >= kTableSize) throw std::out_of_range("FHex index exceeds 64-bit table");
+        return kTable[n];
+    }
+
+    // FHex(n) for any n via fast doubling, O(log n) big-integer multiplies
+    static MicroFixBigUInt fhexBig(uint64_t n) {
+        if (n < kTableSize) return MicroFixBigUInt(kTable[n]);
+        return fastDoubling(n).first;
+    }
+
+    // $hex.range[a::b] in one linear pass over the table
+    static std::vector<uint64_t> range(unsigned a, unsigned b) {
+        if (a > b) return {};
+        if (b >= kTableSize) throw std::out_of_range("$hex.range exceeds 64-bit table, use rangeBig");
+        return std::vector<uint64_t>(kTable.begin() + a, kTable.begin() + b + 1);
+    }
+
+    // $hex.range[a::b] past 64 bits: one doubling seed, then b - a additions
+    static std::vector<MicroFixBigUInt> rangeBig(uint64_t a, uint64_t b) {
+        std::vector<MicroFixBigUInt> out;
+        if (a > b) return out;
+        out.reserve(b - a + 1);
+        auto [current, next] = fastDoubling(a);
+        for (uint64_t i = a; i <= b; ++i) {
+            out.push_back(current);
+            if (i == b) break;
+            MicroFixBigUInt following = current + next;
+            current = std::move(next);
+            next = std::move(following);
+        }
+        return out;
+    }
+
+    // `value in $hex.range[a::b]` without materializing the range
+    static bool inRange(uint64_t value, unsigned a, unsigned b) {
+        if (a > b || a >= kTableSize) return false;  // Terms past the table do not fit in 64 bits
+        if (b >= kTableSize) b = kTableSize - 1;
+        return std::binary_search(kTable.begin() + a, kTable.begin() + b + 1, value);
+    }
+
+private:
+    // Returns {F(n), F(n+1)} using F(2k) = F(k)(2F(k+1) - F(k)), F(2k+1) = F(k)^2 + F(k+1)^2
+    static std::pair<MicroFixBigUInt, MicroFixBigUInt> fastDoubling(uint64_t n) {
+        MicroFixBigUInt a(0), b(1);
+        for (int bit = 63; bit >= 0; --bit) {
+            MicroFixBigUInt c = a * ((b + b) - a);
+            MicroFixBigUInt d = a * a + b * b;
+            if ((n >> bit) & 1) {
+                a = d;
+                b = c + d;
+            } else {
+                a = std::move(c);
+                b = std::move(d);
+            }
+        }
+        return {a, b};
+    }
+};
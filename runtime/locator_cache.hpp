@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Smart locator targets: locate::L1.cache, locate::L2.prefetch, everything else is warm
+enum class MicroFixLocator { L1Cache, L2Prefetch, Warm };
+
+// Maps a directive locator hint (e.g. "L1.cache::prefetch") to its tier
+inline MicroFixLocator parseLocator(std::string_view hint) {
+    if (hint.rfind("locate::", 0) == 0) hint.remove_prefix(8);
+    if (hint.rfind("L1.cache", 0) == 0) return MicroFixLocator::L1Cache;
+    if (hint.rfind("L2.", 0) == 0) return MicroFixLocator::L2Prefetch;
+    return MicroFixLocator::Warm;
+}
+
+struct MicroFixLocatorHint {
+    MicroFixLocator tier = MicroFixLocator::Warm;
+    bool prefetch = false;  // ::prefetch / L2.prefetch: pull entries into the cache ahead of use
+};
+
+inline MicroFixLocatorHint parseLocatorHint(std::string_view hint) {
+    return {parseLocator(hint), hint.find("prefetch") != std::string_view::npos};
+}
+
+// Locator hints declared by a module: `locate::<name>::<tier>` binds one structure, and
+// `cache_mode ::= locate::<tier>` / `cache_access ::= locate::<tier>` set the module default
+class MicroFixLocatorHints {
+public:
+    static MicroFixLocatorHints parse(std::string_view source) {
+        MicroFixLocatorHints hints;
+        while (!source.empty()) {
+            size_t end = source.find('\n');
+            std::string_view line = source.substr(0, end);
+            source.remove_prefix(end == std::string_view::npos ? source.size() : end + 1);
+            size_t at = line.find("locate::");
+            if (at == std::string_view::npos) continue;
+            std::string_view target = line.substr(at + 8);
+            target = target.substr(0, target.find_first_of(" \t\r"));
+            if (line.find("::=") < at) {
+                hints.moduleDefault = parseLocatorHint(target);
+                continue;
+            }
+            size_t split = target.find("::");
+            if (split == std::string_view::npos || parseLocator(target) != MicroFixLocator::Warm) continue;
+            hints.bindings.insert_or_assign(std::string(target.substr(0, split)), parseLocatorHint(target.substr(split + 2)));
+        }
+        return hints;
+    }
+
+    // Empty hints when the module cannot be read, so callers fall back to their defaults
+    static MicroFixLocatorHints load(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) return {};
+        std::stringstream source;
+        source << in.rdbuf();
+        return parse(source.str());
+    }
+
+    bool empty() const { return bindings.empty() && !moduleDefault; }
+
+    // The structure's own binding, else the module default, else fallback
+    MicroFixLocatorHint hintFor(std::string_view name, MicroFixLocatorHint fallback = {}) const {
+        auto it = bindings.find(std::string(name));
+        if (it != bindings.end()) return it->second;
+        return moduleDefault ? *moduleDefault : fallback;
+    }
+
+private:
+    std::unordered_map<std::string, MicroFixLocatorHint> bindings;
+    std::optional<MicroFixLocatorHint> moduleDefault;
+};
+
+struct MicroFixLocatorStats {
+    uint64_t l1Hits = 0;
+    uint64_t l2Hits = 0;
+    uint64_t warmHits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+// Tiered locator-bound store: two small contiguous hot tiers sized to the L1/L2 budgets,
+// backed by a warm hash map. Hot entries live in cache-line aligned arrays so a locator
+// hint decides which memory the data actually sits in. Not thread-safe; one owner per map.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class MicroFixLocatorCache {
+public:
+    explicit MicroFixLocatorCache(size_t l1Bytes = 32 * 1024, size_t l2Bytes = 256 * 1024)
+        : l1(l1Bytes), l2(l2Bytes) {}
+
+    // locate::<tier> — places (or moves) the entry into the requested tier
+    void locate(const Key& key, Value value, MicroFixLocator locator) {
+        erase(key);
+        if (locator == MicroFixLocator::Warm) warm.insert_or_assign(key, std::move(value));
+        else tierFor(locator).insert(key, std::move(value), warm, stats, hasher);
+    }
+
+    // Pointer stays valid until the entry is moved by locate/prefetch/flush or evicted
+    Value* find(const Key& key) {
+        size_t hash = hasher(key);
+        if (Value* hit = l1.find(key, hash)) {
+            ++stats.l1Hits;
+            return hit;
+        }
+        if (Value* hit = l2.find(key, hash)) {
+            ++stats.l2Hits;
+            return hit;
+        }
+        auto it = warm.find(key);
+        if (it == warm.end()) {
+            ++stats.misses;
+            return nullptr;
+        }
+        ++stats.warmHits;
+        return &it->second;
+    }
+
+    // ::prefetch — warm entries are promoted into the L2 tier, then the slot holding the
+    // entry is pulled into the hardware cache ahead of the next find()
+    void prefetch(const Key& key) {
+        size_t hash = hasher(key);
+        if (const Slot* slot = l1.locateSlot(key, hash)) {
+            touch(slot, 3);
+            return;
+        }
+        const Slot* slot = l2.locateSlot(key, hash);
+        if (!slot) {
+            auto it = warm.find(key);
+            if (it == warm.end()) return;
+            Value value = std::move(it->second);
+            warm.erase(it);
+            slot = l2.insert(key, std::move(value), warm, stats, hasher);
+        }
+        touch(slot, 2);
+    }
+
+    // ::flush — demotes the entry from the hot tiers back to warm storage
+    void flush(const Key& key) {
+        size_t hash = hasher(key);
+        for (Tier* tier : {&l1, &l2}) {
+            if (auto slot = tier->take(key, hash)) {
+                warm.insert_or_assign(key, std::move(slot->value));
+                return;
+            }
+        }
+    }
+
+    void flushAll() {
+        l1.drainInto(warm);
+        l2.drainInto(warm);
+    }
+
+    bool erase(const Key& key) {
+        size_t hash = hasher(key);
+        return l1.take(key, hash).has_value() || l2.take(key, hash).has_value() || warm.erase(key) > 0;
+    }
+
+    size_t size() const { return l1.used + l2.used + warm.size(); }
+    size_t hotCapacity(MicroFixLocator locator) const {
+        return locator == MicroFixLocator::L1Cache ? l1.capacity() : locator == MicroFixLocator::L2Prefetch ? l2.capacity() : 0;
+    }
+    const MicroFixLocatorStats& statistics() const { return stats; }
+
+private:
+    static constexpr size_t kProbeWindow = 8;
+
+    struct Slot {
+        Key key{};
+        Value value{};
+        bool occupied = false;
+    };
+
+    // Open-addressed slot array; lookups scan a fixed probe window so erases need no tombstones
+    struct Tier {
+        struct AlignedFree {
+            void operator()(Slot* p) const { ::operator delete[](p, std::align_val_t(64)); }
+        };
+        std::unique_ptr<Slot[], AlignedFree> slots;
+        size_t mask = 0;
+        size_t used = 0;
+
+        explicit Tier(size_t bytes) {
+            size_t count = 1;
+            while (count * 2 * sizeof(Slot) <= bytes) count *= 2;
+            count = std::max(count, kProbeWindow);
+            Slot* raw = static_cast<Slot*>(::operator new[](count * sizeof(Slot), std::align_val_t(64)));
+            for (size_t i = 0; i < count; ++i) new (raw + i) Slot();
+            slots.reset(raw);
+            mask = count - 1;
+        }
+
+        ~Tier() {
+            if (slots) std::destroy_n(slots.get(), mask + 1);
+        }
+
+        size_t capacity() const { return mask + 1; }
+
+        Slot* locateSlot(const Key& key, size_t hash) const {
+            for (size_t i = 0; i < kProbeWindow; ++i) {
+                Slot& slot = slots[(hash + i) & mask];
+                if (slot.occupied && slot.key == key) return &slot;
+            }
+            return nullptr;
+        }
+
+        Value* find(const Key& key, size_t hash) const {
+            Slot* slot = locateSlot(key, hash);
+            return slot ? &slot->value : nullptr;
+        }
+
+        // Evicts the home slot to warm storage when the probe window is full; returns the slot used
+        Slot* insert(const Key& key, Value value, std::unordered_map<Key, Value, Hash>& warm,
+                    MicroFixLocatorStats& stats, const Hash& hasher) {
+            size_t hash = hasher(key);
+            for (size_t i = 0; i < kProbeWindow; ++i) {
+                Slot& slot = slots[(hash + i) & mask];
+                if (!slot.occupied) {
+                    slot.key = key;
+                    slot.value = std::move(value);
+                    slot.occupied = true;
+                    ++used;
+                    return &slot;
+                }
+            }
+            Slot& victim = slots[hash & mask];
+            warm.insert_or_assign(std::move(victim.key), std::move(victim.value));
+            ++stats.evictions;
+            victim.key = key;
+            victim.value = std::move(value);
+            return &victim;
+        }
+
+        std::optional<Slot> take(const Key& key, size_t hash) {
+            Slot* slot = locateSlot(key, hash);
+            if (!slot) return std::nullopt;
+            Slot out = std::move(*slot);
+            *slot = Slot();
+            --used;
+            return out;
+        }
+
+        void drainInto(std::unordered_map<Key, Value, Hash>& warm) {
+            for (size_t i = 0; i <= mask; ++i) {
+                if (slots[i].occupied) {
+                    warm.insert_or_assign(std::move(slots[i].key), std::move(slots[i].value));
+                    slots[i] = Slot();
+                }
+            }
+            used = 0;
+        }
+    };
+
+    Tier l1;
+    Tier l2;
+    std::unordered_map<Key, Value, Hash> warm;
+    MicroFixLocatorStats stats;
+    Hash hasher;
+
+    Tier& tierFor(MicroFixLocator locator) { return locator == MicroFixLocator::L1Cache ? l1 : l2; }
+
+    // Every cache line the slot spans, so values wider than a line arrive whole
+    static void touch(const Slot* slot, int locality) {
+        const char* line = reinterpret_cast<const char*>(slot);
+        for (size_t offset = 0; offset < sizeof(Slot); offset += 64) {
+            if (locality >= 3) __builtin_prefetch(line + offset, 0, 3);
+            else __builtin_prefetch(line + offset, 0, 2);
+        }
+    }
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "vault_cipher.hpp"
+#include "worker_pool.hpp"
+
+// Encrypted-at-rest page store behind the Memory Vault. Every page is sealed on its own
+// with the vault cipher; the nonce is (page index, write generation), so rewriting a page
+// never reuses a nonce under the vault key. Pages are only ever plaintext in the caller's
+// buffer. Distinct pages may be read and written concurrently; one page may not.
+class MicroFixEncryptedVault {
+public:
+    using Key = std::array<uint8_t, MicroFixVaultCipher::kKeyBytes>;
+    static constexpr size_t kDefaultPageBytes = 4096;
+
+    // Fresh key per vault: a key must never be reused for a second vault instance
+    static Key generateKey() {
+        std::random_device entropy;
+        Key key;
+        for (size_t i = 0; i < key.size(); i += 4) {
+            uint32_t word = entropy();
+            std::memcpy(key.data() + i, &word, 4);
+        }
+        return key;
+    }
+
+    MicroFixEncryptedVault(size_t pages, const Key& key, size_t pageBytes = kDefaultPageBytes,
+                           std::optional<MicroFixVaultCipherKind> forced = std::nullopt)
+        : cipher(key.data(), forced), pages(pages), bytesPerPage(pageBytes),
+          sealed(pages * pageBytes), tags(pages * MicroFixVaultCipher::kTagBytes), generations(pages, 0) {
+        if (pageBytes == 0 || pageBytes % 16 != 0) throw std::invalid_argument("Vault page size must be a multiple of 16");
+        if (pages > UINT32_MAX) throw std::length_error("Vault page index exceeds nonce space");
+    }
+
+    size_t pageCount() const { return pages; }
+    size_t pageBytes() const { return bytesPerPage; }
+    MicroFixVaultCipherKind cipherKind() const { return cipher.kind(); }
+
+    // Seals one full page of plaintext
+    void write(size_t page, const uint8_t* plain) {
+        checkPage(page);
+        uint64_t generation = ++generations[page];
+        uint8_t nonce[MicroFixVaultCipher::kNonceBytes];
+        makeNonce(page, generation, nonce);
+        cipher.seal(nonce, nullptr, 0, plain, sealedAt(page), bytesPerPage, tagAt(page));
+    }
+
+    // Throws if the sealed page or its tag was altered; never-written pages read as zeros
+    void read(size_t page, uint8_t* plain) const {
+        checkPage(page);
+        uint64_t generation = generations[page];
+        if (generation == 0) {
+            std::memset(plain, 0, bytesPerPage);
+            return;
+        }
+        uint8_t nonce[MicroFixVaultCipher::kNonceBytes];
+        makeNonce(page, generation, nonce);
+        if (!cipher.open(nonce, nullptr, 0, sealedAt(page), plain, bytesPerPage, tagAt(page))) {
+            throw std::runtime_error("Vault page " + std::to_string(page) + " failed authentication");
+        }
+    }
+
+    // Seals count consecutive pages from one contiguous buffer, split across the pool when given
+    void writeBatch(size_t first, size_t count, const uint8_t* plain, MicroFixWorkerPool* pool = nullptr) {
+        forEachPage(first, count, pool, [&](size_t page) { write(page, plain + (page - first) * bytesPerPage); });
+    }
+
+    void readBatch(size_t first, size_t count, uint8_t* plain, MicroFixWorkerPool* pool = nullptr) const {
+        forEachPage(first, count, pool, [&](size_t page) { read(page, plain + (page - first) * bytesPerPage); });
+    }
+
+    // Sealed form of a page, for integrity trees and persistence
+    const uint8_t* sealedPage(size_t page) const { return sealedAt(page); }
+    const uint8_t* pageTag(size_t page) const { return tagAt(page); }
+    uint64_t generation(size_t page) const { return generations.at(page); }
+
+private:
+    static constexpr size_t kPagesPerChunk = 16;  // Keeps chunk dispatch cost small next to sealing
+
+    MicroFixVaultCipher cipher;
+    size_t pages;
+    size_t bytesPerPage;
+    std::vector<uint8_t> sealed;
+    std::vector<uint8_t> tags;
+    std::vector<uint64_t> generations;
+
+    void checkPage(size_t page) const {
+        if (page >= pages) throw std::out_of_range("Vault page out of range");
+    }
+
+    uint8_t* sealedAt(size_t page) { return sealed.data() + page * bytesPerPage; }
+    const uint8_t* sealedAt(size_t page) const { return sealed.data() + page * bytesPerPage; }
+    uint8_t* tagAt(size_t page) { return tags.data() + page * MicroFixVaultCipher::kTagBytes; }
+    const uint8_t* tagAt(size_t page) const { return tags.data() + page * MicroFixVaultCipher::kTagBytes; }
+
+    static void makeNonce(size_t page, uint64_t generation, uint8_t* nonce) {
+        uint32_t index = static_cast<uint32_t>(page);
+        std::memcpy(nonce, &index, sizeof(index));
+        std::memcpy(nonce + sizeof(index), &generation, sizeof(generation));
+    }
+
+    template <class Fn>
+    void forEachPage(size_t first, size_t count, MicroFixWorkerPool* pool, Fn&& fn) const {
+        if (count == 0) return;
+        if (first + count > pages) throw std::out_of_range("Vault batch out of range");
+        size_t chunks = (count + kPagesPerChunk - 1) / kPagesPerChunk;
+        auto runChunk = [&](size_t chunk, size_t) {
+            size_t begin = first + chunk * kPagesPerChunk;
+            size_t end = std::min(first + count, begin + kPagesPerChunk);
+            for (size_t page = begin; page < end; ++page) fn(page);
+        };
+        if (!pool || chunks == 1) {
+            for (size_t chunk = 0; chunk < chunks; ++chunk) runChunk(chunk, 0);
+            return;
+        }
+        std::vector<std::exception_ptr> failures(chunks);
+        pool->parallelFor(chunks, [&](size_t chunk, size_t slot) {
+            try {
+                runChunk(chunk, slot);
+            } catch (...) {
+                failures[chunk] = std::current_exception();
+            }
+        });
+        for (auto& failure : failures) {
+            if (failure) std::rethrow_exception(failure);
+        }
+    }
+};
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// proof(x)::by(y)::when(z)::range(a::b)::validate::@locator
+struct MicroFixProofChain {
+    std::string subject;
+    std::string prover;
+    std::string condition;  // Empty when the chain has no when(...)
+    bool hasRange = false;
+    uint64_t rangeLo = 0;
+    uint64_t rangeHi = 0;
+    bool validate = false;
+    std::string locator;
+
+    static MicroFixProofChain parse(std::string_view text) {
+        MicroFixProofChain chain;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            // Split on "::" outside parentheses so range(0xA::0xF) stays one segment
+            size_t end = pos;
+            int depth = 0;
+            while (end < text.size() && !(depth == 0 && text.compare(end, 2, "::") == 0)) {
+                if (text[end] == '(') ++depth;
+                if (text[end] == ')') --depth;
+                ++end;
+            }
+            chain.applySegment(text.substr(pos, end - pos));
+            pos = end + 2;
+        }
+        if (chain.subject.empty()) throw std::invalid_argument("Proof chain missing proof(...)");
+        return chain;
+    }
+
+private:
+    static std::string_view argument(std::string_view segment) {
+        size_t open = segment.find('(');
+        size_t close = segment.rfind(')');
+        if (open == std::string_view::npos || close == std::string_view::npos || close < open) {
+            throw std::invalid_argument("Malformed proof segment: " + std::string(segment));
+        }
+        std::string_view arg = segment.substr(open + 1, close - open - 1);
+        if (arg.size() >= 2 && arg.front() == '"' && arg.back() == '"') arg = arg.substr(1, arg.size() - 2);
+        return arg;
+    }
+
+    void applySegment(std::string_view segment) {
+        if (segment.rfind("proof(", 0) == 0) subject = argument(segment);
+        else if (segment.rfind("by(", 0) == 0) prover = argument(segment);
+        else if (segment.rfind("when(", 0) == 0) condition = argument(segment);
+        else if (segment.rfind("range(", 0) == 0) {
+            std::string bounds(argument(segment));
+            size_t split = bounds.find("::");
+            if (split == std::string::npos) throw std::invalid_argument("Malformed proof range: " + bounds);
+            rangeLo = std::stoull(bounds.substr(0, split), nullptr, 0);
+            rangeHi = std::stoull(bounds.substr(split + 2), nullptr, 0);
+            hasRange = true;
+        } else if (segment == "validate") validate = true;
+        else if (!segment.empty() && segment.front() == '@') locator = segment.substr(1);
+        else throw std::invalid_argument("Unknown proof segment: " + std::string(segment));
+    }
+};
+
+// Versioned proof input: every write bumps the version, which is what invalidates memoized proofs
+class MicroFixProofInput {
+public:
+    void set(bool value) {
+        truth.store(value, std::memory_order_relaxed);
+        currentVersion.fetch_add(1, std::memory_order_release);
+    }
+
+    void touch() { currentVersion.fetch_add(1, std::memory_order_release); }
+
+    bool value() const { return truth.load(std::memory_order_relaxed); }
+    uint64_t version() const { return currentVersion.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<bool> truth{false};
+    std::atomic<uint64_t> currentVersion{1};
+};
+
+// Evaluates proof chains once per input version and replays the result until an input changes
+class MicroFixProofEngine {
+public:
+    using Prover = std::function<bool(const MicroFixProofChain&)>;
+
+    // Replacing a prover drops all memoized results, since they may have come from the old one.
+    // The generation bump also rejects results that evaluations still running on the old
+    // prover store afterwards.
+    void registerProver(const std::string& name, Prover prover) {
+        {
+            std::unique_lock<std::shared_mutex> lock(registryLock);
+            provers[name] = std::make_shared<Prover>(std::move(prover));
+            proverGeneration.fetch_add(1, std::memory_order_acq_rel);
+        }
+        clear();
+    }
+
+    // Inputs are created on first use and live as long as the engine
+    MicroFixProofInput& input(const std::string& name) {
+        {
+            std::shared_lock<std::shared_mutex> lock(registryLock);
+            auto it = inputs.find(name);
+            if (it != inputs.end()) return *it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(registryLock);
+        auto& slot = inputs[name];
+        if (!slot) slot = std::make_unique<MicroFixProofInput>();
+        return *slot;
+    }
+
+    bool evaluate(std::string_view text) { return evaluate(MicroFixProofChain::parse(text)); }
+
+    bool evaluate(const MicroFixProofChain& chain) {
+        MicroFixProofInput& subject = input(chain.subject);
+        MicroFixProofInput* condition = chain.condition.empty() ? nullptr : &input(chain.condition);
+        uint64_t subjectVersion = subject.version();
+        uint64_t conditionVersion = condition ? condition->version() : 0;
+        // Read before the prover is looked up, so a result is never tagged newer than its prover
+        uint64_t generation = proverGeneration.load(std::memory_order_acquire);
+
+        std::string key = memoKey(chain);
+        Shard& shard = shards[std::hash<std::string>{}(key) % kShards];
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.lock);
+            auto it = shard.memo.find(key);
+            if (it != shard.memo.end() && it->second.subjectVersion == subjectVersion &&
+                it->second.conditionVersion == conditionVersion && it->second.generation == generation) {
+                hitCount.fetch_add(1, std::memory_order_relaxed);
+                return it->second.result;
+            }
+        }
+        missCount.fetch_add(1, std::memory_order_relaxed);
+
+        bool result = false;
+        if (!condition || condition->value()) {
+            std::shared_ptr<Prover> prover;
+            {
+                std::shared_lock<std::shared_mutex> lock(registryLock);
+                auto it = provers.find(chain.prover);
+                if (it != provers.end()) prover = it->second;
+            }
+            result = prover ? (*prover)(chain) : subject.value();  // No by(...): the subject's own truth
+        }
+
+        std::unique_lock<std::shared_mutex> lock(shard.lock);
+        if (generation == proverGeneration.load(std::memory_order_acquire)) {
+            shard.memo[key] = Entry{subjectVersion, conditionVersion, generation, result};
+        }
+        return result;
+    }
+
+    // Drops every memoized proof whose subject or condition is name
+    void invalidate(const std::string& name) {
+        input(name).touch();
+    }
+
+    void clear() {
+        for (auto& shard : shards) {
+            std::unique_lock<std::shared_mutex> lock(shard.lock);
+            shard.memo.clear();
+        }
+    }
+
+    uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kShards = 16;
+
+    struct Entry {
+        uint64_t subjectVersion;
+        uint64_t conditionVersion;
+        uint64_t generation;  // Prover registrations seen when the result was computed
+        bool result;
+    };
+
+    struct Shard {
+        std::shared_mutex lock;
+        std::unordered_map<std::string, Entry> memo;
+    };
+
+    std::shared_mutex registryLock;
+    std::unordered_map<std::string, std::shared_ptr<Prover>> provers;
+    std::unordered_map<std::string, std::unique_ptr<MicroFixProofInput>> inputs;
+    std::array<Shard, kShards> shards;
+    std::atomic<uint64_t> hitCount{0};
+    std::atomic<uint64_t> missCount{0};
+    std::atomic<uint64_t> proverGeneration{0};
+
+    // Every field the prover can observe, so chains differing only in ::validate or @locator
+    // never share a verdict
+    static std::string memoKey(const MicroFixProofChain& chain) {
+        std::string key;
+        key.reserve(chain.subject.size() + chain.prover.size() + chain.condition.size() + chain.locator.size() + 48);
+        key.append(chain.subject).push_back('\0');
+        key.append(chain.prover).push_back('\0');
+        key.append(chain.condition).push_back('\0');
+        key.append(chain.locator).push_back('\0');
+        key.push_back(chain.validate ? 'v' : '-');
+        if (chain.hasRange) key.append("r").append(std::to_string(chain.rangeLo)).append(":").append(std::to_string(chain.rangeHi));
+        return key;
+    }
+};
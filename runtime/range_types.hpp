@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Smallest unsigned type that holds every value up to Max
+template <uint64_t Max>
+using MicroFixRangeStorage = std::conditional_t<Max <= UINT8_MAX, uint8_t,
+                             std::conditional_t<Max <= UINT16_MAX, uint16_t,
+                             std::conditional_t<Max <= UINT32_MAX, uint32_t, uint64_t>>>;
+
+// UInt#range[Lo::Hi]: bounds live in the type, so the value is as small and as cheap as
+// a plain integer. Checks happen only at the edges where a raw integer enters the range;
+// literals are checked at compile time, and widening or range arithmetic needs none.
+template <uint64_t Lo, uint64_t Hi>
+class MicroFixUIntRange {
+    static_assert(Lo <= Hi, "UInt#range lower bound exceeds upper bound");
+
+public:
+    using storage_type = MicroFixRangeStorage<Hi>;
+    static constexpr uint64_t lo = Lo;
+    static constexpr uint64_t hi = Hi;
+
+    constexpr MicroFixUIntRange() : raw(static_cast<storage_type>(Lo)) {}
+
+    // Proven in-range: any narrower range converts without a check
+    template <uint64_t Lo2, uint64_t Hi2>
+        requires(Lo <= Lo2 && Hi2 <= Hi)
+    constexpr MicroFixUIntRange(MicroFixUIntRange<Lo2, Hi2> other) : raw(static_cast<storage_type>(other.value())) {}
+
+    // Compile-time literal, e.g. MicroFixSensorValue::of<512>()
+    template <uint64_t V>
+    static constexpr MicroFixUIntRange of() {
+        static_assert(V >= Lo && V <= Hi, "Literal outside UInt#range bounds");
+        return MicroFixUIntRange(V, Trusted{});
+    }
+
+    // Runtime entry point from an unbounded integer
+    static constexpr MicroFixUIntRange checked(uint64_t v) {
+        if (v < Lo || v > Hi) throw std::out_of_range("Value outside UInt#range bounds");
+        return MicroFixUIntRange(v, Trusted{});
+    }
+
+    static constexpr MicroFixUIntRange saturate(uint64_t v) { return MicroFixUIntRange(v < Lo ? Lo : v > Hi ? Hi : v, Trusted{}); }
+
+    // Caller guarantees the bound (e.g. value came out of a validated batch); asserted in debug builds
+    static constexpr MicroFixUIntRange trusted(uint64_t v) {
+        assert(v >= Lo && v <= Hi);
+        return MicroFixUIntRange(v, Trusted{});
+    }
+
+    static constexpr bool contains(uint64_t v) { return v >= Lo && v <= Hi; }
+
+    constexpr storage_type value() const { return raw; }
+    constexpr operator storage_type() const { return raw; }
+
+    // Result range is computed from the operand ranges, so no overflow or bounds check is needed;
+    // bounds whose sum would wrap uint64_t get no range overload and add as plain integers
+    template <uint64_t Lo2, uint64_t Hi2>
+        requires(Hi <= UINT64_MAX - Hi2)
+    friend constexpr MicroFixUIntRange<Lo + Lo2, Hi + Hi2> operator+(MicroFixUIntRange a, MicroFixUIntRange<Lo2, Hi2> b) {
+        return MicroFixUIntRange<Lo + Lo2, Hi + Hi2>::trusted(uint64_t(a.value()) + b.value());
+    }
+
+    friend constexpr bool operator==(MicroFixUIntRange a, MicroFixUIntRange b) { return a.raw == b.raw; }
+    friend constexpr auto operator<=>(MicroFixUIntRange a, MicroFixUIntRange b) { return a.raw <=> b.raw; }
+
+private:
+    struct Trusted {};
+    constexpr MicroFixUIntRange(uint64_t v, Trusted) : raw(static_cast<storage_type>(v)) {}
+
+    storage_type raw;
+};
+
+// range::<UInt#range[0::1024]> from define::sensor_validator
+using MicroFixSensorValue = MicroFixUIntRange<0, 1024>;
+static_assert(sizeof(MicroFixSensorValue) == sizeof(uint16_t));
+
+// RegBank#map[Lo:Hi]: one slot per register, indexed directly by register number
+template <uint64_t Lo, uint64_t Hi, class T>
+class MicroFixRegBankMap {
+public:
+    using Index = MicroFixUIntRange<Lo, Hi>;
+    static constexpr size_t size() { return Hi - Lo + 1; }
+
+    // Range-typed index: the bound is proven by the type, so no check
+    template <uint64_t Lo2, uint64_t Hi2>
+        requires(Lo <= Lo2 && Hi2 <= Hi)
+    constexpr T& operator[](MicroFixUIntRange<Lo2, Hi2> reg) { return bank[reg.value() - Lo]; }
+
+    template <uint64_t Lo2, uint64_t Hi2>
+        requires(Lo <= Lo2 && Hi2 <= Hi)
+    constexpr const T& operator[](MicroFixUIntRange<Lo2, Hi2> reg) const { return bank[reg.value() - Lo]; }
+
+    // Raw register number: checked
+    constexpr T& at(uint64_t reg) { return bank[Index::checked(reg).value() - Lo]; }
+    constexpr const T& at(uint64_t reg) const { return bank[Index::checked(reg).value() - Lo]; }
+
+    constexpr T* begin() { return bank.data(); }
+    constexpr T* end() { return bank.data() + size(); }
+
+private:
+    std::array<T, Hi - Lo + 1> bank{};
+};
+
+// Dense array of UInt#range values: each element takes bit_width(Hi - Lo) bits
+template <uint64_t Lo, uint64_t Hi>
+class MicroFixPackedRangeArray {
+public:
+    using Value = MicroFixUIntRange<Lo, Hi>;
+    static constexpr unsigned kBits = std::bit_width(Hi - Lo) == 0 ? 1 : std::bit_width(Hi - Lo);
+    static_assert(kBits <= 64);
+
+    explicit MicroFixPackedRangeArray(size_t count = 0) : count(count), words((count * kBits + 63) / 64 + 1) {}
+
+    size_t size() const { return count; }
+    size_t bytes() const { return words.size() * sizeof(uint64_t); }
+
+    Value get(size_t i) const {
+        size_t bit = i * kBits;
+        size_t word = bit / 64;
+        unsigned shift = bit % 64;
+        uint64_t bits = words[word] >> shift;
+        if (shift + kBits > 64) bits |= words[word + 1] << (64 - shift);
+        return Value::trusted(Lo + (bits & kMask));
+    }
+
+    void set(size_t i, Value v) {
+        uint64_t offset = uint64_t(v.value()) - Lo;
+        size_t bit = i * kBits;
+        size_t word = bit / 64;
+        unsigned shift = bit % 64;
+        words[word] = (words[word] & ~(kMask << shift)) | (offset << shift);
+        if (shift + kBits > 64) {
+            unsigned spill = 64 - shift;
+            words[word + 1] = (words[word + 1] & ~(kMask >> spill)) | (offset >> spill);
+        }
+    }
+
+private:
+    static constexpr uint64_t kMask = kBits == 64 ? ~uint64_t(0) : (uint64_t(1) << kBits) - 1;
+
+    size_t count;
+    std::vector<uint64_t> words;  // One spare word so straddling reads never branch on the end
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+#include "descriptor_store.hpp"
+
+// Undo log behind `toggle X to Y during Z`. Each toggle appends what it changed, and
+// reverting to a mark undoes newer entries newest first. A descriptor store toggled
+// Mutable reverts to Immutable: its written pages are published on commit and dropped
+// on rollback, so nothing is copied up front. A store that is already Mutable gets a
+// savepoint instead, so a nested window undoes only its own writes. Entries are plain
+// structs in a reused vector, so entering and leaving a window allocates nothing in
+// steady state.
+class MicroFixToggleLog {
+public:
+    // Shared by every scope on the thread so nested windows unwind in order
+    static MicroFixToggleLog& forThread() {
+        thread_local MicroFixToggleLog log;
+        return log;
+    }
+
+    size_t mark() const { return entries.size(); }
+
+    void setFlag(bool& flag, bool value) {
+        entries.push_back({Entry::Flag, &flag, nullptr, flag});
+        flag = value;
+    }
+
+    // A store already Mutable belongs to an outer window (or its caller), which keeps the session
+    void makeMutable(MicroFixDescriptorStore& store) {
+        if (store.state() == MicroFixMemoryState::Mutable) {
+            store.savepoint();
+            entries.push_back({Entry::Savepoint, nullptr, &store, false});
+            return;
+        }
+        store.toggle(MicroFixMemoryState::Mutable);
+        entries.push_back({Entry::Store, nullptr, &store, false});
+    }
+
+    // Publishes from every store go out as one retire batch
+    void revertTo(size_t mark, bool commit) {
+        MicroFixRetireBatch batch;
+        while (entries.size() > mark) {
+            Entry entry = entries.back();
+            entries.pop_back();
+            if (entry.kind == Entry::Flag) {
+                *entry.flag = entry.previous;
+            } else if (entry.kind == Entry::Savepoint) {
+                if (entry.store->savepointDepth() == 0) continue;  // The session was ended inside the window
+                if (commit) entry.store->releaseSavepoint();
+                else entry.store->rollbackSavepoint();
+            } else if (!commit) {
+                entry.store->discard();
+            } else {
+                try {
+                    entry.store->toggle(MicroFixMemoryState::Immutable, &batch);
+                } catch (...) {
+                    entry.store->discard();  // Could not seal the copies; the published version stays intact
+                }
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        enum Kind { Flag, Store, Savepoint } kind;
+        bool* flag;
+        MicroFixDescriptorStore* store;
+        bool previous;
+    };
+
+    std::vector<Entry> entries;
+};
+
+// RAII window over the thread's toggle log: everything toggled through it reverts when the
+// scope ends. Leaving normally commits descriptor writes; leaving by exception or after
+// rollback() discards them.
+class MicroFixScopedToggle {
+public:
+    explicit MicroFixScopedToggle(MicroFixToggleLog& log = MicroFixToggleLog::forThread())
+        : log(log), start(log.mark()), exceptionsOnEntry(std::uncaught_exceptions()) {}
+
+    ~MicroFixScopedToggle() { log.revertTo(start, !rolledBack && std::uncaught_exceptions() == exceptionsOnEntry); }
+
+    MicroFixScopedToggle(const MicroFixScopedToggle&) = delete;
+    MicroFixScopedToggle& operator=(const MicroFixScopedToggle&) = delete;
+
+    MicroFixScopedToggle& mutableDuring(MicroFixDescriptorStore& store) {
+        log.makeMutable(store);
+        return *this;
+    }
+
+    // Many units entering the same window at once
+    MicroFixScopedToggle& mutableDuring(const std::vector<MicroFixDescriptorStore*>& stores) {
+        for (MicroFixDescriptorStore* store : stores) log.makeMutable(*store);
+        return *this;
+    }
+
+    MicroFixScopedToggle& flagDuring(bool& flag, bool value) {
+        log.setFlag(flag, value);
+        return *this;
+    }
+
+    void rollback() { rolledBack = true; }
+
+private:
+    MicroFixToggleLog& log;
+    size_t start;
+    int exceptionsOnEntry;
+    bool rolledBack = false;
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MICROFIX_X86_SIMD 1
+#endif
+
+#include "hexlib.hpp"
+#include "locator_cache.hpp"
+
+// Struct-of-arrays sensor block: one lane per sensor, matching modules/sensorproof
+struct MicroFixSensorBlock {
+    std::vector<uint32_t> values;
+    std::vector<uint8_t> active;  // trueon = 1, falsiff = 0
+
+    size_t size() const { return values.size(); }
+
+    void push(uint32_t value, bool isActive) {
+        values.push_back(value);
+        active.push_back(isActive ? 1 : 0);
+    }
+};
+
+struct MicroFixSensorRecord {
+    uint32_t value = 0;
+    bool active = false;
+};
+
+// sensor_map is locator-bound: init_sensor_map places it with locate::sensor_map::L1.cache
+using MicroFixSensorMap = MicroFixLocatorCache<uint32_t, MicroFixSensorRecord>;
+
+inline void initSensorMap(MicroFixSensorMap& sensorMap, size_t simulated = 24,
+                          MicroFixLocatorHint placement = parseLocatorHint("L1.cache")) {
+    for (uint32_t id = 0; id < simulated; ++id) {
+        uint64_t value = MicroFixHexLib::fhex(0xA + id % (0x2F - 0xA + 1));
+        sensorMap.locate(id, MicroFixSensorRecord{static_cast<uint32_t>(value), true}, placement.tier);
+    }
+}
+
+// Placement taken from the module's own `locate::sensor_map::<tier>` line
+inline void initSensorMap(MicroFixSensorMap& sensorMap, const MicroFixLocatorHints& module, size_t simulated = 24) {
+    initSensorMap(sensorMap, simulated, module.hintFor("sensor_map", parseLocatorHint("L1.cache")));
+}
+
+// Batch form of validate(sensor): `sensor.value in $hex.range[a::b] and sensor.active == trueon`
+class MicroFixSensorProof {
+public:
+    explicit MicroFixSensorProof(unsigned rangeLo = 0xA, unsigned rangeHi = 0x2F) {
+        for (uint64_t value : MicroFixHexLib::range(rangeLo, std::min(rangeHi, MicroFixHexLib::kTableSize - 1))) {
+            if (value > std::numeric_limits<uint32_t>::max()) break;
+            if (proofValues.empty() || proofValues.back() != value) proofValues.push_back(static_cast<uint32_t>(value));
+        }
+#ifdef MICROFIX_X86_SIMD
+        useAvx2 = __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    bool validate(uint32_t value, bool isActive) const {
+        return isActive && std::binary_search(proofValues.begin(), proofValues.end(), value);
+    }
+
+    // Writes one verified bit per sensor into mask[(count + 63) / 64]
+    void validateBatch(const uint32_t* values, const uint8_t* active, size_t count, uint64_t* mask) const {
+        size_t words = (count + 63) / 64;
+        std::fill(mask, mask + words, 0);
+        size_t i = 0;
+#ifdef MICROFIX_X86_SIMD
+        if (!proofValues.empty()) {
+            i = useAvx2 ? validateAvx2(values, active, count, mask) : validateSse2(values, active, count, mask);
+        }
+#endif
+        for (; i < count; ++i) {
+            if (validate(values[i], active[i] != 0)) mask[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+
+    std::vector<uint64_t> validateBatch(const MicroFixSensorBlock& block) const {
+        std::vector<uint64_t> mask((block.size() + 63) / 64);
+        validateBatch(block.values.data(), block.active.data(), block.size(), mask.data());
+        return mask;
+    }
+
+    static size_t countVerified(const std::vector<uint64_t>& mask) {
+        size_t total = 0;
+        for (uint64_t word : mask) total += __builtin_popcountll(word);
+        return total;
+    }
+
+private:
+    std::vector<uint32_t> proofValues;  // Sorted, deduplicated FHex values that fit a sensor lane
+    bool useAvx2 = false;
+
+#ifdef MICROFIX_X86_SIMD
+    // Both kernels return the number of sensors handled; the scalar loop finishes the tail
+    __attribute__((target("avx2")))
+    size_t validateAvx2(const uint32_t* values, const uint8_t* active, size_t count, uint64_t* mask) const {
+        const __m256i zero = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            __m256i hit = zero;
+            for (uint32_t proof : proofValues) {
+                hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(lanes, _mm256_set1_epi32(static_cast<int>(proof))));
+            }
+            __m128i flagBytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(active + i));
+            __m256i on = _mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(flagBytes), zero);
+            uint64_t bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(hit, on))));
+            mask[i / 64] |= bits << (i % 64);
+        }
+        return i;
+    }
+
+    size_t validateSse2(const uint32_t* values, const uint8_t* active, size_t count, uint64_t* mask) const {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+            __m128i hit = zero;
+            for (uint32_t proof : proofValues) {
+                hit = _mm_or_si128(hit, _mm_cmpeq_epi32(lanes, _mm_set1_epi32(static_cast<int>(proof))));
+            }
+            int32_t flagWord;
+            __builtin_memcpy(&flagWord, active + i, sizeof(flagWord));
+            __m128i flags = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(flagWord), zero), zero);
+            __m128i on = _mm_cmpgt_epi32(flags, zero);
+            uint64_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(hit, on))));
+            mask[i / 64] |= bits << (i % 64);
+        }
+        return i;
+    }
+#endif
+};
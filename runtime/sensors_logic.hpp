@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "sensorproof.hpp"
+#include "worker_pool.hpp"
+
+struct MicroFixNetworkResult {
+    size_t verified = 0;
+    size_t routed = 0;
+};
+
+// Parallel run_network: chunked validation on the worker pool, serial ordered drain
+class MicroFixSensorNetwork {
+public:
+    MicroFixSensorNetwork(MicroFixWorkerPool& pool, const MicroFixSensorProof& proof, size_t chunkSize = 4096)
+        : pool(pool), proof(proof), chunkSize(std::max<size_t>(64, chunkSize / 64 * 64)), failureQueues(pool.slotCount()) {}
+
+    // Validates every sensor, then calls logValid(id) or autoFallback(id) on the calling thread
+    // in sensor order, so the stream log stays ordered per sensor id. ids defaults to the lane index.
+    template <class LogFn, class FallbackFn>
+    MicroFixNetworkResult runNetwork(const MicroFixSensorBlock& sensors, LogFn&& logValid, FallbackFn&& autoFallback,
+                                     const std::vector<uint32_t>* ids = nullptr) {
+        size_t count = sensors.size();
+        mask.assign((count + 63) / 64, 0);
+        for (auto& queue : failureQueues) queue.failed.clear();
+
+        // Chunks are multiples of 64 sensors, so no two threads ever share a mask word
+        size_t chunks = (count + chunkSize - 1) / chunkSize;
+        pool.parallelFor(chunks, [&](size_t chunk, size_t slot) {
+            size_t begin = chunk * chunkSize;
+            size_t len = std::min(chunkSize, count - begin);
+            uint64_t* words = mask.data() + begin / 64;
+            proof.validateBatch(sensors.values.data() + begin, sensors.active.data() + begin, len, words);
+            auto& failed = failureQueues[slot].failed;
+            for (size_t i = 0; i < len; ++i) {
+                if (!((words[i / 64] >> (i % 64)) & 1)) failed.push_back(static_cast<uint32_t>(begin + i));
+            }
+        });
+
+        // Each per-thread queue is ascending (chunks are claimed in order), so a k-way merge
+        // reproduces the serial iteration order of sensor_set.
+        using Head = std::pair<uint32_t, size_t>;
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+        std::vector<size_t> cursor(failureQueues.size(), 0);
+        for (size_t q = 0; q < failureQueues.size(); ++q) {
+            if (!failureQueues[q].failed.empty()) heads.emplace(failureQueues[q].failed[0], q);
+        }
+
+        MicroFixNetworkResult result;
+        auto idOf = [&](size_t index) { return ids ? (*ids)[index] : static_cast<uint32_t>(index); };
+        size_t index = 0;
+        auto logUntil = [&](size_t end) {
+            for (; index < end; ++index) {
+                logValid(idOf(index));
+                ++result.verified;
+            }
+        };
+        while (!heads.empty()) {
+            auto [failedIndex, q] = heads.top();
+            heads.pop();
+            logUntil(failedIndex);
+            autoFallback(idOf(failedIndex));
+            ++result.routed;
+            index = failedIndex + 1;
+            if (++cursor[q] < failureQueues[q].failed.size()) heads.emplace(failureQueues[q].failed[cursor[q]], q);
+        }
+        logUntil(count);
+        return result;
+    }
+
+private:
+    struct alignas(64) FailureQueue {
+        std::vector<uint32_t> failed;
+    };
+
+    MicroFixWorkerPool& pool;
+    const MicroFixSensorProof& proof;
+    size_t chunkSize;
+    std::vector<uint64_t> mask;
+    std::vector<FailureQueue> failureQueues;  // One per pool slot, reused across frames
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MICROFIX_X86_SIMD 1
+#endif
+
+using MicroFixDigest = std::array<uint8_t, 32>;
+
+// Streaming SHA-256 (FIPS 180-4); compresses with the SHA extensions when the CPU has them
+class MicroFixSha256 {
+public:
+    static MicroFixDigest hash(const void* data, size_t len) {
+        MicroFixSha256 sha;
+        sha.update(data, len);
+        return sha.finish();
+    }
+
+    static bool hardwareShaAvailable() {
+#ifdef MICROFIX_X86_SIMD
+        static const bool available = __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    void update(const void* data, size_t len) {
+        const uint8_t* in = static_cast<const uint8_t*>(data);
+        total += len;
+        if (buffered > 0) {
+            size_t take = len < 64 - buffered ? len : 64 - buffered;
+            std::memcpy(buffer + buffered, in, take);
+            buffered += take;
+            in += take;
+            len -= take;
+            if (buffered < 64) return;
+            compress(buffer, 1);
+            buffered = 0;
+        }
+        if (len >= 64) {
+            compress(in, len / 64);
+            in += len & ~size_t(63);
+            len &= 63;
+        }
+        std::memcpy(buffer, in, len);
+        buffered = len;
+    }
+
+    MicroFixDigest finish() {
+        uint64_t bits = total * 8;
+        uint8_t pad[72] = {0x80};
+        size_t padLen = (buffered < 56 ? 56 : 120) - buffered;
+        for (int i = 0; i < 8; ++i) pad[padLen + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+        update(pad, padLen + 8);
+        MicroFixDigest digest;
+        for (int i = 0; i < 8; ++i) {
+            digest[4 * i] = static_cast<uint8_t>(state[i] >> 24);
+            digest[4 * i + 1] = static_cast<uint8_t>(state[i] >> 16);
+            digest[4 * i + 2] = static_cast<uint8_t>(state[i] >> 8);
+            digest[4 * i + 3] = static_cast<uint8_t>(state[i]);
+        }
+        return digest;
+    }
+
+private:
+    static constexpr uint32_t kRound[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    uint32_t state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    uint8_t buffer[64];
+    size_t buffered = 0;
+    uint64_t total = 0;
+
+    void compress(const uint8_t* blocks, size_t count) {
+#ifdef MICROFIX_X86_SIMD
+        if (hardwareShaAvailable()) return compressShaNi(blocks, count);
+#endif
+        compressPortable(blocks, count);
+    }
+
+    static uint32_t rotr(uint32_t v, int bits) { return (v >> bits) | (v << (32 - bits)); }
+
+    void compressPortable(const uint8_t* blocks, size_t count) {
+        for (; count > 0; --count, blocks += 64) {
+            uint32_t w[64];
+            for (int i = 0; i < 16; ++i) {
+                w[i] = uint32_t(blocks[4 * i]) << 24 | uint32_t(blocks[4 * i + 1]) << 16 |
+                       uint32_t(blocks[4 * i + 2]) << 8 | uint32_t(blocks[4 * i + 3]);
+            }
+            for (int i = 16; i < 64; ++i) {
+                uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+            uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+            uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+            for (int i = 0; i < 64; ++i) {
+                uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + kRound[i] + w[i];
+                uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                h = g; g = f; f = e; e = d + t1;
+                d = c; c = b; b = a; a = t1 + t2;
+            }
+            state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        }
+    }
+
+#ifdef MICROFIX_X86_SIMD
+    // SHA-NI: two rounds per sha256rnds2 with the state held as ABEF/CDGH; the message
+    // schedule for four rounds ahead is built with sha256msg1/msg2 while rounds run
+    __attribute__((target("sha,sse4.1")))
+    void compressShaNi(const uint8_t* blocks, size_t count) {
+        const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+        __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+        __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+        __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+        for (; count > 0; --count, blocks += 64) {
+            __m128i savedAbef = state0, savedCdgh = state1;
+            __m128i msg[4];
+#pragma GCC unroll 16
+            for (int group = 0; group < 16; ++group) {
+                __m128i& current = msg[group % 4];
+                if (group < 4) {
+                    current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks) + group), byteSwap);
+                }
+                __m128i words = _mm_add_epi32(current, _mm_loadu_si128(reinterpret_cast<const __m128i*>(kRound + 4 * group)));
+                state1 = _mm_sha256rnds2_epu32(state1, state0, words);
+                if (group >= 3 && group <= 14) {
+                    __m128i& next = msg[(group + 1) % 4];
+                    next = _mm_add_epi32(next, _mm_alignr_epi8(current, msg[(group + 3) % 4], 4));
+                    next = _mm_sha256msg2_epu32(next, current);
+                }
+                state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(words, 0x0E));
+                if (group >= 1 && group <= 12) {
+                    __m128i& previous = msg[(group + 3) % 4];
+                    previous = _mm_sha256msg1_epu32(previous, current);
+                }
+            }
+            state0 = _mm_add_epi32(state0, savedAbef);
+            state1 = _mm_add_epi32(state1, savedCdgh);
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1B);
+        state1 = _mm_shuffle_epi32(state1, 0xB1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(tmp, state1, 0xF0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(state1, tmp, 8));
+    }
+#endif
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "stream_queue.hpp"
+
+// Columnar sensor records moved between StreamNodes as one unit
+struct MicroFixSensorBatch {
+    explicit MicroFixSensorBatch(size_t capacity)
+        : capacity(capacity),
+          ids(new uint32_t[capacity]),
+          values(new uint32_t[capacity]),
+          active(new uint8_t[capacity]),
+          verified(new uint64_t[(capacity + 63) / 64]()) {}
+
+    const size_t capacity;
+    size_t count = 0;
+    std::unique_ptr<uint32_t[]> ids;
+    std::unique_ptr<uint32_t[]> values;
+    std::unique_ptr<uint8_t[]> active;
+    std::unique_ptr<uint64_t[]> verified;  // Filled by the validation stage, one bit per record
+
+    bool full() const { return count == capacity; }
+    bool empty() const { return count == 0; }
+
+    bool push(uint32_t id, uint32_t value, bool isActive) {
+        if (full()) return false;
+        ids[count] = id;
+        values[count] = value;
+        active[count] = isActive ? 1 : 0;
+        ++count;
+        return true;
+    }
+
+    bool isVerified(size_t i) const { return (verified[i / 64] >> (i % 64)) & 1; }
+
+    void clear() { count = 0; }
+};
+
+struct MicroFixBatchTuning {
+    size_t batchSize = 512;                            // Records per hop
+    std::chrono::microseconds latencyTarget{200};      // Max age of the oldest record in a partial batch
+    size_t pooledBatches = 1024;                       // Recycled batches kept warm
+};
+
+// Recycles batches so a steady-state pipeline hop moves a pointer and allocates nothing.
+// The pool must outlive every handle it hands out.
+class MicroFixBatchPool {
+public:
+    struct Recycler {
+        MicroFixBatchPool* pool = nullptr;
+        void operator()(MicroFixSensorBatch* batch) const {
+            if (pool) pool->recycle(batch);
+            else delete batch;
+        }
+    };
+    using Handle = std::unique_ptr<MicroFixSensorBatch, Recycler>;
+
+    explicit MicroFixBatchPool(const MicroFixBatchTuning& tuning = {})
+        : batchSize(tuning.batchSize), freeList(tuning.pooledBatches) {}
+
+    ~MicroFixBatchPool() {
+        while (auto batch = freeList.tryPop()) delete *batch;
+    }
+
+    MicroFixBatchPool(const MicroFixBatchPool&) = delete;
+    MicroFixBatchPool& operator=(const MicroFixBatchPool&) = delete;
+
+    Handle acquire() {
+        MicroFixSensorBatch* batch = nullptr;
+        if (auto pooled = freeList.tryPop()) batch = *pooled;
+        else batch = new MicroFixSensorBatch(batchSize);
+        batch->clear();
+        return Handle(batch, Recycler{this});
+    }
+
+    size_t size() const { return batchSize; }
+
+private:
+    size_t batchSize;
+    MicroFixMpmcQueue<MicroFixSensorBatch*> freeList;
+
+    void recycle(MicroFixSensorBatch* batch) {
+        if (!freeList.tryPush(batch)) delete batch;
+    }
+};
+
+struct MicroFixBatchRecord {
+    uint32_t id = 0;
+    uint32_t value = 0;
+    bool active = false;
+};
+
+// What a record poll found: a record, nothing yet, or the end of the stream
+enum class MicroFixBatchPoll { Record, Idle, Exhausted };
+
+// Fills batches record by record and seals them on size or latency, whichever comes first
+class MicroFixBatchBuilder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    MicroFixBatchBuilder(MicroFixBatchPool& pool, std::chrono::microseconds latencyTarget = MicroFixBatchTuning{}.latencyTarget)
+        : pool(pool), latencyTarget(latencyTarget) {}
+
+    // Returns the sealed batch once it is full, otherwise an empty handle
+    MicroFixBatchPool::Handle add(uint32_t id, uint32_t value, bool isActive) {
+        if (!open) {
+            open = pool.acquire();
+            openedAt = Clock::now();
+        }
+        open->push(id, value, isActive);
+        if (open->full()) return std::move(open);
+        return {};
+    }
+
+    // Seals a partial batch whose oldest record has waited past the latency target
+    MicroFixBatchPool::Handle flushIfStale(Clock::time_point now = Clock::now()) {
+        if (open && now - openedAt >= latencyTarget) {
+            ++staleSeals;
+            return std::move(open);
+        }
+        return {};
+    }
+
+    MicroFixBatchPool::Handle flush() { return open && !open->empty() ? std::move(open) : MicroFixBatchPool::Handle(); }
+
+    // StreamNode source body: pulls records through poll(record) and emits each sealed batch.
+    // The latency target is checked after every record that does not fill the batch and on
+    // every idle poll, so a slow stream still ships its partial batch whether poll trickles
+    // records, blocks, or reports Idle. The tail is flushed once poll reports the end. The
+    // builder must outlive the returned source.
+    template <class Poll>
+    auto source(Poll poll) {
+        return [this, poll = std::move(poll)](auto& out) mutable {
+            MicroFixBatchRecord record;
+            for (;;) {
+                switch (poll(record)) {
+                case MicroFixBatchPoll::Record:
+                    if (auto sealed = add(record.id, record.value, record.active)) {
+                        out.emit(std::move(sealed));
+                        return true;
+                    }
+                    if (auto stale = flushIfStale()) {
+                        out.emit(std::move(stale));
+                        return true;
+                    }
+                    break;
+                case MicroFixBatchPoll::Idle:
+                    if (auto stale = flushIfStale()) out.emit(std::move(stale));
+                    return true;
+                case MicroFixBatchPoll::Exhausted:
+                    if (auto tail = flush()) out.emit(std::move(tail));
+                    return false;
+                }
+            }
+        };
+    }
+
+    // Partial batches sealed by the latency target rather than by filling up
+    size_t sealedStale() const { return staleSeals; }
+
+private:
+    MicroFixBatchPool& pool;
+    std::chrono::microseconds latencyTarget;
+    MicroFixBatchPool::Handle open;
+    Clock::time_point openedAt;
+    size_t staleSeals = 0;
+};
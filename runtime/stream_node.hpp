@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "stream_queue.hpp"
+#include "worker_pool.hpp"
+
+// Celarion StreamNodes: a DAG of directive stages joined by bounded queues.
+// Every edge carries credits, so a node only runs for as many items as all of its
+// downstream queues can accept; a full stage stalls its producers instead of a worker.
+template <class T>
+class MicroFixStreamGraph {
+public:
+    using NodeId = size_t;
+
+    class Emitter {
+    public:
+        // Forwards the item to every downstream node; at most one emit per input item
+        void emit(T item) {
+            if (emitted == budget) throw std::logic_error("StreamNode emitted more items than it consumed");
+            ++emitted;
+            auto& outputs = graph.nodes[node]->outputs;
+            for (size_t i = 0; i < outputs.size(); ++i) {
+                Node& target = *graph.nodes[outputs[i]];
+                graph.inFlight.fetch_add(1, std::memory_order_relaxed);
+                if constexpr (std::is_copy_constructible_v<T>) {
+                    target.input->push(i + 1 == outputs.size() ? std::move(item) : T(item));
+                } else {
+                    target.input->push(std::move(item));
+                }
+            }
+        }
+
+    private:
+        friend class MicroFixStreamGraph;
+        Emitter(MicroFixStreamGraph& graph, NodeId node, size_t budget) : graph(graph), node(node), budget(budget) {}
+        MicroFixStreamGraph& graph;
+        NodeId node;
+        size_t budget;
+        size_t emitted = 0;
+    };
+
+    using SourceFn = std::function<bool(Emitter&)>;       // Emits at most one item; false once exhausted
+    using StageFn = std::function<void(T&&, Emitter&)>;   // Emits zero or one item per input
+
+    explicit MicroFixStreamGraph(size_t burst = 64) : burst(burst) {}
+
+    NodeId addSource(std::string name, SourceFn fn) {
+        auto node = std::make_unique<Node>(std::move(name), 0);
+        node->source = std::move(fn);
+        return addNode(std::move(node));
+    }
+
+    NodeId addStage(std::string name, StageFn fn, size_t inputCapacity = 1024) {
+        auto node = std::make_unique<Node>(std::move(name), inputCapacity);
+        node->stage = std::move(fn);
+        return addNode(std::move(node));
+    }
+
+    void connect(NodeId from, NodeId to) {
+        if (nodes.at(to)->source) throw std::logic_error("StreamNode source cannot take inputs");
+        if constexpr (!std::is_copy_constructible_v<T>) {
+            if (!nodes.at(from)->outputs.empty()) throw std::logic_error("Move-only StreamNode items cannot fan out");
+        }
+        nodes.at(from)->outputs.push_back(to);
+        ++nodes[to]->inDegree;
+        order.clear();
+    }
+
+    // Kahn's algorithm; throws on a cycle so a bad directive stream fails at load time
+    const std::vector<NodeId>& topologicalOrder() {
+        if (!order.empty() || nodes.empty()) return order;
+        std::vector<size_t> indegree(nodes.size());
+        for (auto& node : nodes) indegree[node->id] = node->inDegree;
+        std::deque<NodeId> frontier;
+        for (auto& node : nodes) {
+            if (indegree[node->id] == 0) frontier.push_back(node->id);
+        }
+        while (!frontier.empty()) {
+            NodeId id = frontier.front();
+            frontier.pop_front();
+            order.push_back(id);
+            for (NodeId next : nodes[id]->outputs) {
+                if (--indegree[next] == 0) frontier.push_back(next);
+            }
+        }
+        if (order.size() != nodes.size()) {
+            order.clear();
+            throw std::logic_error("StreamNode graph contains a cycle");
+        }
+        return order;
+    }
+
+    // StreamNode.Trigger("name"): runs the graph with only the named source armed. If a source
+    // or stage throws, the run stops, queued items are discarded and the first error is rethrown.
+    void trigger(const std::string& sourceName, MicroFixWorkerPool& pool) {
+        bool found = false;
+        for (auto& node : nodes) {
+            if (!node->source) continue;
+            bool armed = node->name == sourceName;
+            node->armed = armed;
+            found = found || armed;
+        }
+        if (!found) throw std::invalid_argument("Unknown StreamNode source: " + sourceName);
+        execute(pool);
+    }
+
+    // Runs every source to exhaustion and drains all stages
+    void run(MicroFixWorkerPool& pool) {
+        for (auto& node : nodes) node->armed = static_cast<bool>(node->source);
+        execute(pool);
+    }
+
+    NodeId find(const std::string& name) const {
+        for (auto& node : nodes) {
+            if (node->name == name) return node->id;
+        }
+        throw std::invalid_argument("Unknown StreamNode: " + name);
+    }
+
+    size_t processed(NodeId id) const { return nodes.at(id)->processed.load(std::memory_order_relaxed); }
+
+private:
+    // Input edge of a node: SPSC when exactly one upstream node feeds it, MPMC otherwise
+    struct InputQueue {
+        std::unique_ptr<MicroFixSpscQueue<T>> spsc;
+        std::unique_ptr<MicroFixMpmcQueue<T>> mpmc;
+        std::atomic<ptrdiff_t> credits{0};
+
+        InputQueue(size_t capacity, bool singleProducer) {
+            if (singleProducer) spsc = std::make_unique<MicroFixSpscQueue<T>>(capacity);
+            else mpmc = std::make_unique<MicroFixMpmcQueue<T>>(capacity);
+            credits.store(static_cast<ptrdiff_t>(spsc ? spsc->capacity() : mpmc->capacity()));
+        }
+
+        // Producer claims up to want slots; push() is then guaranteed to succeed
+        size_t reserve(size_t want) {
+            ptrdiff_t available = credits.load(std::memory_order_relaxed);
+            for (;;) {
+                ptrdiff_t take = std::min<ptrdiff_t>(available, static_cast<ptrdiff_t>(want));
+                if (take <= 0) return 0;
+                if (credits.compare_exchange_weak(available, available - take, std::memory_order_acq_rel)) return take;
+            }
+        }
+
+        void release(size_t count) { credits.fetch_add(static_cast<ptrdiff_t>(count), std::memory_order_acq_rel); }
+
+        void push(T item) {
+            bool pushed = spsc ? spsc->tryPush(std::move(item)) : mpmc->tryPush(std::move(item));
+            if (!pushed) throw std::logic_error("StreamNode queue overflow despite reserved credit");
+        }
+
+        std::optional<T> pop() {
+            std::optional<T> item = spsc ? spsc->tryPop() : mpmc->tryPop();
+            if (item) release(1);
+            return item;
+        }
+
+        size_t sizeApprox() const { return spsc ? spsc->sizeApprox() : mpmc->sizeApprox(); }
+    };
+
+    struct Node {
+        Node(std::string name, size_t inputCapacity) : name(std::move(name)), inputCapacity(inputCapacity) {}
+        NodeId id = 0;
+        std::string name;
+        size_t inputCapacity;
+        SourceFn source;
+        StageFn stage;
+        std::vector<NodeId> outputs;
+        size_t inDegree = 0;
+        std::unique_ptr<InputQueue> input;
+        bool armed = false;
+        std::atomic<bool> exhausted{false};
+        std::atomic<bool> running{false};
+        std::atomic<size_t> processed{0};
+    };
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::vector<NodeId> order;
+    size_t burst;
+    std::atomic<size_t> inFlight{0};
+    std::atomic<size_t> activeNodes{0};
+    std::atomic<size_t> activations{0};
+    std::atomic<bool> failed{false};
+    std::mutex failureLock;
+    std::exception_ptr failure;
+
+    NodeId addNode(std::unique_ptr<Node> node) {
+        node->id = nodes.size();
+        nodes.push_back(std::move(node));
+        order.clear();
+        return nodes.back()->id;
+    }
+
+    void execute(MicroFixWorkerPool& pool) {
+        const auto& topo = topologicalOrder();
+        for (auto& node : nodes) {
+            node->exhausted = !node->armed && static_cast<bool>(node->source);
+            if (!node->source && !node->input) node->input = std::make_unique<InputQueue>(node->inputCapacity, node->inDegree <= 1);
+        }
+        failed.store(false);
+        failure = nullptr;
+        // Sinks first: draining downstream stages frees credits before sources produce more
+        std::vector<NodeId> schedule(topo.rbegin(), topo.rend());
+        pool.parallelFor(pool.slotCount(), [&](size_t, size_t) {
+            for (;;) {
+                bool progressed = false;
+                for (NodeId id : schedule) {
+                    if (failed.load(std::memory_order_acquire)) return;
+                    progressed = activate(*nodes[id]) || progressed;
+                }
+                if (progressed) continue;
+                if (finished()) return;
+                std::this_thread::yield();
+            }
+        });
+        if (!failure) return;
+        // Every worker has left the graph; drop what the failed run left queued so it can run again
+        for (auto& node : nodes) {
+            if (node->input) {
+                while (node->input->pop()) {}
+            }
+        }
+        inFlight.store(0);
+        std::rethrow_exception(failure);
+    }
+
+    void fail(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(failureLock);
+        if (!failure) failure = std::move(error);
+        failed.store(true, std::memory_order_release);
+    }
+
+    // Quiescent when nothing is queued, no source can produce, and no activation
+    // started while we were looking
+    bool finished() const {
+        size_t started = activations.load();
+        if (activeNodes.load() != 0 || inFlight.load() != 0) return false;
+        for (auto& node : nodes) {
+            if (node->source && !node->exhausted.load()) return false;
+        }
+        return activeNodes.load() == 0 && activations.load() == started;
+    }
+
+    // Ends an activation however it leaves: unused credits go back and the node is released
+    struct Activation {
+        MicroFixStreamGraph& graph;
+        Node& node;
+        std::vector<size_t> granted;
+        Emitter emitter;
+        size_t done = 0;
+
+        ~Activation() {
+            node.processed.fetch_add(done, std::memory_order_relaxed);
+            for (size_t i = 0; i < node.outputs.size(); ++i) {
+                if (granted[i] > emitter.emitted) graph.nodes[node.outputs[i]]->input->release(granted[i] - emitter.emitted);
+            }
+            node.running.store(false, std::memory_order_release);
+            graph.activeNodes.fetch_sub(1);
+        }
+    };
+
+    bool activate(Node& node) {
+        if (node.source ? node.exhausted.load(std::memory_order_acquire) : node.input->sizeApprox() == 0) return false;
+        activations.fetch_add(1);
+        activeNodes.fetch_add(1);
+        if (node.running.exchange(true, std::memory_order_acquire)) {
+            activeNodes.fetch_sub(1);
+            return false;
+        }
+
+        Activation run{*this, node, std::vector<size_t>(node.outputs.size()), Emitter(*this, node.id, 0)};
+        size_t want = node.source ? burst : std::min(burst, node.input->sizeApprox());
+        for (size_t i = 0; i < node.outputs.size() && want > 0; ++i) {
+            run.granted[i] = nodes[node.outputs[i]]->input->reserve(want);
+            want = std::min(want, run.granted[i]);
+        }
+
+        try {
+            for (; run.done < want; ++run.done) {
+                run.emitter.budget = run.done + 1;
+                if (node.source) {
+                    if (!node.source(run.emitter)) {
+                        node.exhausted.store(true, std::memory_order_release);
+                        break;
+                    }
+                } else {
+                    std::optional<T> item = node.input->pop();
+                    if (!item) break;
+                    inFlight.fetch_sub(1, std::memory_order_relaxed);  // Consumed even if the stage throws
+                    node.stage(std::move(*item), run.emitter);
+                }
+            }
+        } catch (...) {
+            fail(std::current_exception());
+            return false;
+        }
+        return run.done > 0;
+    }
+};
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+// Ring size for a requested capacity: a power of two, at least 2, so indices wrap with a mask
+inline size_t ringSlots(size_t capacity) {
+    size_t slots = 2;
+    while (slots < capacity) slots <<= 1;
+    return slots;
+}
+
+// Bounded single-producer/single-consumer ring between two StreamNodes
+template <class T>
+class MicroFixSpscQueue {
+public:
+    explicit MicroFixSpscQueue(size_t capacity) : mask(ringSlots(capacity) - 1), slots(new std::optional<T>[mask + 1]) {}
+
+    size_t capacity() const { return mask + 1; }
+
+    bool tryPush(T item) {
+        size_t tail = tailPos.load(std::memory_order_relaxed);
+        if (tail - cachedHead == capacity()) {
+            cachedHead = headPos.load(std::memory_order_acquire);
+            if (tail - cachedHead == capacity()) return false;
+        }
+        slots[tail & mask].emplace(std::move(item));
+        tailPos.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> tryPop() {
+        size_t head = headPos.load(std::memory_order_relaxed);
+        if (head == cachedTail) {
+            cachedTail = tailPos.load(std::memory_order_acquire);
+            if (head == cachedTail) return std::nullopt;
+        }
+        std::optional<T> item = std::move(slots[head & mask]);
+        slots[head & mask].reset();
+        headPos.store(head + 1, std::memory_order_release);
+        return item;
+    }
+
+    size_t sizeApprox() const {
+        return tailPos.load(std::memory_order_acquire) - headPos.load(std::memory_order_acquire);
+    }
+
+private:
+    const size_t mask;
+    std::unique_ptr<std::optional<T>[]> slots;
+    alignas(64) std::atomic<size_t> headPos{0};
+    size_t cachedTail = 0;  // Consumer-side copy of tailPos
+    alignas(64) std::atomic<size_t> tailPos{0};
+    size_t cachedHead = 0;  // Producer-side copy of headPos
+};
+
+// Bounded multi-producer/multi-consumer ring (per-slot sequence numbers, no locks)
+template <class T>
+class MicroFixMpmcQueue {
+public:
+    explicit MicroFixMpmcQueue(size_t capacity) : mask(ringSlots(capacity) - 1), cells(new Cell[mask + 1]) {
+        for (size_t i = 0; i <= mask; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    bool tryPush(T item) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value.emplace(std::move(item));
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::optional<T> tryPop() {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    std::optional<T> item = std::move(cell.value);
+                    cell.value.reset();
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return item;
+                }
+            } else if (diff < 0) {
+                return std::nullopt;
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t sizeApprox() const {
+        size_t tail = enqueuePos.load(std::memory_order_acquire);
+        size_t head = dequeuePos.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        std::optional<T> value;
+    };
+
+    const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+};
+
+// Bounded multi-producer/single-consumer ring: producers never take a lock and never
+// wait on the consumer, and the consumer drains in batches without CAS traffic
+template <class T>
+class MicroFixMpscRing {
+public:
+    explicit MicroFixMpscRing(size_t capacity) : mask(ringSlots(capacity) - 1), cells(new Cell[mask + 1]) {
+        for (size_t i = 0; i <= mask; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Returns false instead of blocking when the ring is full
+    bool tryPush(T item) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(item);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer only: hands up to maxItems published items to fn(T&), oldest first
+    template <class Fn>
+    size_t drain(Fn&& fn, size_t maxItems = static_cast<size_t>(-1)) {
+        size_t drained = 0;
+        while (drained < maxItems) {
+            Cell& cell = cells[dequeuePos & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1) break;
+            fn(cell.value);
+            cell.value = T();
+            cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+            ++dequeuePos;
+            ++drained;
+        }
+        return drained;
+    }
+
+    // Consumer only
+    size_t sizeApprox() const {
+        size_t tail = enqueuePos.load(std::memory_order_acquire);
+        return tail > dequeuePos ? tail - dequeuePos : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value{};
+    };
+
+    const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos = 0;  // Owned by the single consumer
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include "event_loop.hpp"
+#include "locator_cache.hpp"
+
+// Side effects of modules/streamlogic auto_fallback, supplied by the host runtime
+struct MicroFixFallbackHooks {
+    std::function<void(uint32_t)> reboot;         // attempt::reboot(sensor)
+    std::function<bool(uint32_t)> rebooted;       // proof(sensor.rebooted)
+    std::function<void(uint32_t)> markRestored;   // mark::"restored"
+    std::function<void(uint32_t)> safeMode;       // toggle::sensor_safe_mode
+    std::function<void(uint32_t)> pushAlert;      // push::alert_stream
+};
+
+enum class MicroFixFallbackState : uint8_t { Pending, Restored, Alerted, Failed };
+
+struct MicroFixFallbackRecord {
+    MicroFixFallbackState state = MicroFixFallbackState::Pending;
+    uint32_t attempts = 0;
+};
+
+// auto_fallback as a coroutine on the event loop: a pending reboot costs one frame, not a thread.
+// Per-sensor fallback records are streamlogic's locator-bound data, placed by the module's
+// `cache_access ::= locate::<tier>` hint and only touched on the loop thread.
+class MicroFixStreamLogic {
+public:
+    MicroFixStreamLogic(MicroFixEventLoop& loop, MicroFixFallbackHooks hooks,
+                        std::chrono::milliseconds rebootWait = std::chrono::seconds(5),
+                        MicroFixLocatorHint recordPlacement = parseLocatorHint("L2.prefetch"))
+        : loop(loop), hooks(std::move(hooks)), rebootWait(rebootWait), placement(recordPlacement) {}
+
+    MicroFixStreamLogic(const MicroFixStreamLogic&) = delete;
+    MicroFixStreamLogic& operator=(const MicroFixStreamLogic&) = delete;
+
+    // Sequences still waiting on the loop are dropped; see MicroFixEventLoop::cancel
+    ~MicroFixStreamLogic() { loop.cancel(this); }
+
+    // Returns immediately; the outcome is applied on the loop thread once wait:: elapses
+    void autoFallback(uint32_t sensorId) {
+        pendingCount.fetch_add(1, std::memory_order_relaxed);
+        loop.post([this, sensorId] { fallbackSequence(sensorId); }, this);
+    }
+
+    size_t pending() const { return pendingCount.load(std::memory_order_relaxed); }
+    size_t restored() const { return restoredCount.load(std::memory_order_relaxed); }
+    size_t alerted() const { return alertedCount.load(std::memory_order_relaxed); }
+    size_t failed() const { return failedCount.load(std::memory_order_relaxed); }
+
+    // Latest outcome for the sensor; call on the loop thread or while the loop is idle
+    std::optional<MicroFixFallbackRecord> record(uint32_t sensorId) {
+        const MicroFixFallbackRecord* found = records.find(sensorId);
+        return found ? std::optional<MicroFixFallbackRecord>(*found) : std::nullopt;
+    }
+
+    const MicroFixLocatorStats& recordStats() const { return records.statistics(); }
+
+    // First hook failure, if any; the sequence that hit it ends without a restored/alerted outcome
+    std::exception_ptr firstFailure() const {
+        std::lock_guard<std::mutex> lock(failureLock);
+        return failure;
+    }
+
+private:
+    MicroFixEventLoop& loop;
+    MicroFixFallbackHooks hooks;
+    std::chrono::milliseconds rebootWait;
+    MicroFixLocatorHint placement;
+    MicroFixLocatorCache<uint32_t, MicroFixFallbackRecord> records;
+    std::atomic<size_t> pendingCount{0};
+    std::atomic<size_t> restoredCount{0};
+    std::atomic<size_t> alertedCount{0};
+    std::atomic<size_t> failedCount{0};
+    mutable std::mutex failureLock;
+    std::exception_ptr failure;
+
+    void settle(uint32_t sensorId, MicroFixFallbackState state) {
+        if (MicroFixFallbackRecord* found = records.find(sensorId)) found->state = state;
+    }
+
+    MicroFixDetachedTask fallbackSequence(uint32_t sensorId) {
+        try {
+            MicroFixFallbackRecord* previous = records.find(sensorId);
+            uint32_t attempts = previous ? previous->attempts + 1 : 1;
+            records.locate(sensorId, MicroFixFallbackRecord{MicroFixFallbackState::Pending, attempts}, placement.tier);
+            hooks.reboot(sensorId);
+            co_await loop.sleepFor(rebootWait, this);
+            // Other sequences may have moved the record meanwhile; pull it back while the probe runs
+            if (placement.prefetch) records.prefetch(sensorId);
+            if (hooks.rebooted(sensorId)) {
+                hooks.markRestored(sensorId);
+                settle(sensorId, MicroFixFallbackState::Restored);
+                restoredCount.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                hooks.safeMode(sensorId);
+                hooks.pushAlert(sensorId);
+                settle(sensorId, MicroFixFallbackState::Alerted);
+                alertedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        } catch (...) {
+            settle(sensorId, MicroFixFallbackState::Failed);
+            failedCount.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(failureLock);
+            if (!failure) failure = std::current_exception();
+        }
+        pendingCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
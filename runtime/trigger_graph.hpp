@@ -0,0 +1,229 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "worker_pool.hpp"
+
+// How a node with several upstream outcomes decides to fire within one cascade
+enum class MicroFixTriggerJoin { Any, All };
+
+// `outcome X triggers Y` chains as a graph loaded once and fired many times. Nodes are
+// outcomes and the units they trigger; a node's action returns true when its own outcome
+// is reached, which triggers its successors. load() rejects cycles, so every cascade ends.
+// Firing is iterative: a finished node runs one ready successor itself and submits the
+// rest to the worker pool, so deep chains never grow a call stack.
+class MicroFixTriggerGraph {
+public:
+    using Action = std::function<bool()>;
+
+    // A running cascade; the graph must outlive it
+    class Cascade {
+        struct State {
+            explicit State(size_t nodes) : waiting(new std::atomic<uint32_t>[nodes]), fired(new std::atomic<bool>[nodes]) {
+                for (size_t node = 0; node < nodes; ++node) fired[node].store(false, std::memory_order_relaxed);
+            }
+
+            std::unique_ptr<std::atomic<uint32_t>[]> waiting;  // Arrivals still needed before a node fires
+            std::unique_ptr<std::atomic<bool>[]> fired;
+            std::atomic<size_t> outstanding{0};                 // Nodes triggered but not yet finished
+            std::atomic<size_t> firedCount{0};
+            std::mutex doneLock;
+            std::condition_variable doneSignal;
+            std::exception_ptr failure;
+        };
+
+    public:
+        // Blocks until every triggered node has run; rethrows the first action failure
+        void wait() {
+            std::unique_lock<std::mutex> lock(state->doneLock);
+            state->doneSignal.wait(lock, [&] { return state->outstanding.load(std::memory_order_acquire) == 0; });
+            if (state->failure) std::rethrow_exception(state->failure);
+        }
+
+        bool fired(size_t node) const { return state->fired[node].load(std::memory_order_acquire); }
+        size_t firedCount() const { return state->firedCount.load(std::memory_order_acquire); }
+
+    private:
+        friend class MicroFixTriggerGraph;
+        explicit Cascade(std::shared_ptr<State> state) : state(std::move(state)) {}
+        std::shared_ptr<State> state;
+    };
+
+    explicit MicroFixTriggerGraph(MicroFixWorkerPool* pool = nullptr) : pool(pool) {}
+
+    // A node without an action always reaches its outcome
+    size_t addNode(const std::string& name, Action action = {}, MicroFixTriggerJoin join = MicroFixTriggerJoin::Any) {
+        if (loaded) throw std::logic_error("Trigger graph is already loaded");
+        if (byName.count(name)) throw std::invalid_argument("Duplicate trigger node " + name);
+        byName[name] = nodes.size();
+        nodes.push_back({name, std::move(action), join});
+        return nodes.size() - 1;
+    }
+
+    void addTrigger(const std::string& outcome, const std::string& unit) {
+        if (loaded) throw std::logic_error("Trigger graph is already loaded");
+        edges.push_back({index(outcome), index(unit)});
+    }
+
+    // Builds the successor table and rejects cycles, naming the nodes on one
+    void load() {
+        size_t count = nodes.size();
+        successorStart.assign(count + 1, 0);
+        predecessorCount.assign(count, 0);
+        for (const auto& [from, to] : edges) {
+            ++successorStart[from + 1];
+            ++predecessorCount[to];
+        }
+        for (size_t node = 0; node < count; ++node) successorStart[node + 1] += successorStart[node];
+        successors.resize(edges.size());
+        std::vector<size_t> cursor(successorStart.begin(), successorStart.end() - 1);
+        for (const auto& [from, to] : edges) successors[cursor[from]++] = static_cast<uint32_t>(to);
+
+        // Kahn's algorithm: whatever never reaches in-degree zero sits on or behind a cycle
+        std::vector<uint32_t> indegree(predecessorCount.begin(), predecessorCount.end());
+        std::vector<size_t> ready;
+        for (size_t node = 0; node < count; ++node) {
+            if (indegree[node] == 0) ready.push_back(node);
+        }
+        size_t visited = 0;
+        while (!ready.empty()) {
+            size_t node = ready.back();
+            ready.pop_back();
+            ++visited;
+            for (size_t i = successorStart[node]; i < successorStart[node + 1]; ++i) {
+                if (--indegree[successors[i]] == 0) ready.push_back(successors[i]);
+            }
+        }
+        if (visited != count) throw std::invalid_argument("Trigger cycle: " + describeCycle(indegree));
+        loaded = true;
+    }
+
+    size_t index(const std::string& name) const {
+        auto it = byName.find(name);
+        if (it == byName.end()) throw std::out_of_range("Unknown trigger node " + name);
+        return it->second;
+    }
+
+    size_t size() const { return nodes.size(); }
+    const std::string& name(size_t node) const { return nodes.at(node).name; }
+
+    Cascade fire(const std::string& outcome) { return fire(std::vector<size_t>{index(outcome)}); }
+
+    // Roots run unconditionally; everything else fires through its join rule
+    Cascade fire(const std::vector<size_t>& roots) {
+        if (!loaded) throw std::logic_error("Trigger graph must be loaded before firing");
+        for (size_t root : roots) {
+            if (root >= nodes.size()) throw std::out_of_range("Trigger root out of range");
+        }
+        auto state = std::make_shared<Cascade::State>(nodes.size());
+        for (size_t node = 0; node < nodes.size(); ++node) {
+            state->waiting[node].store(nodes[node].join == MicroFixTriggerJoin::All ? predecessorCount[node] : 1,
+                                       std::memory_order_relaxed);
+        }
+        for (size_t root : roots) state->waiting[root].store(0, std::memory_order_relaxed);  // Upstream arrivals must not rerun a root
+        state->outstanding.store(roots.size() + 1, std::memory_order_relaxed);  // +1 until every root is dispatched
+        for (size_t root : roots) dispatch(state, root);
+        finishOne(*state);
+        return Cascade(state);
+    }
+
+private:
+    struct Node {
+        std::string name;
+        Action action;
+        MicroFixTriggerJoin join;
+    };
+
+    MicroFixWorkerPool* pool;
+    bool loaded = false;
+    std::vector<Node> nodes;
+    std::unordered_map<std::string, size_t> byName;
+    std::vector<std::pair<size_t, size_t>> edges;
+    std::vector<size_t> successorStart;  // successors[successorStart[n] .. successorStart[n + 1])
+    std::vector<uint32_t> successors;
+    std::vector<uint32_t> predecessorCount;
+
+    void dispatch(const std::shared_ptr<Cascade::State>& state, size_t node) {
+        if (pool) pool->submit([this, state, node] { runFrom(state, node); });
+        else runFrom(state, node);
+    }
+
+    // Runs node, then keeps going with its first ready successor; other ready ones are dispatched
+    void runFrom(const std::shared_ptr<Cascade::State>& owner, size_t node) {
+        Cascade::State& state = *owner;
+        std::vector<size_t> local;  // Pool-less cascades keep their ready set here
+        for (;;) {
+            bool reached = true;
+            try {
+                if (nodes[node].action) reached = nodes[node].action();
+            } catch (...) {
+                reached = false;
+                std::lock_guard<std::mutex> lock(state.doneLock);
+                if (!state.failure) state.failure = std::current_exception();
+            }
+            state.fired[node].store(reached, std::memory_order_release);
+            if (reached) state.firedCount.fetch_add(1, std::memory_order_relaxed);
+
+            size_t next = SIZE_MAX;
+            if (reached) {
+                for (size_t i = successorStart[node]; i < successorStart[node + 1]; ++i) {
+                    uint32_t successor = successors[i];
+                    if (state.waiting[successor].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+                    state.outstanding.fetch_add(1, std::memory_order_relaxed);
+                    if (next == SIZE_MAX) next = successor;
+                    else if (!pool) local.push_back(successor);
+                    else dispatch(owner, successor);
+                }
+            }
+            finishOne(state);
+            if (next == SIZE_MAX && !local.empty()) {
+                next = local.back();
+                local.pop_back();
+            }
+            if (next == SIZE_MAX) return;
+            node = next;
+        }
+    }
+
+    static void finishOne(Cascade::State& state) {
+        if (state.outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(state.doneLock);
+            state.doneSignal.notify_all();
+        }
+    }
+
+    // Walks predecessors among the unvisited nodes until one repeats
+    std::string describeCycle(const std::vector<uint32_t>& indegree) const {
+        std::vector<std::vector<size_t>> predecessors(nodes.size());
+        for (const auto& [from, to] : edges) predecessors[to].push_back(from);
+        size_t node = 0;
+        while (indegree[node] == 0) ++node;
+        std::vector<size_t> seenAt(nodes.size(), SIZE_MAX);
+        std::vector<size_t> path;
+        while (seenAt[node] == SIZE_MAX) {
+            seenAt[node] = path.size();
+            path.push_back(node);
+            for (size_t predecessor : predecessors[node]) {
+                if (indegree[predecessor] != 0) {
+                    node = predecessor;
+                    break;
+                }
+            }
+        }
+        // path[i + 1] triggers path[i], so the cycle reads forward from the repeated node
+        std::string cycle = nodes[node].name;
+        for (size_t i = path.size(); i-- > seenAt[node];) cycle += " -> " + nodes[path[i]].name;
+        return cycle;
+    }
+};
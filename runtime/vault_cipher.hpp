@@ -0,0 +1,505 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MICROFIX_X86_SIMD 1
+#endif
+
+enum class MicroFixVaultCipherKind { Aes256Gcm, ChaCha20Poly1305 };
+
+// Page AEAD for the memory vault: AES-256-GCM on AES-NI + PCLMUL hosts, ChaCha20-Poly1305
+// (RFC 8439) everywhere else. Both take a 32-byte key, a 12-byte nonce and a 16-byte tag,
+// so sealed pages only differ in which kind() produced them.
+class MicroFixVaultCipher {
+public:
+    static constexpr size_t kKeyBytes = 32;
+    static constexpr size_t kNonceBytes = 12;
+    static constexpr size_t kTagBytes = 16;
+
+    static bool hardwareAesAvailable() {
+#ifdef MICROFIX_X86_SIMD
+        return __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+#else
+        return false;
+#endif
+    }
+
+    explicit MicroFixVaultCipher(const uint8_t* key, std::optional<MicroFixVaultCipherKind> forced = std::nullopt)
+        : cipherKind(forced.value_or(hardwareAesAvailable() ? MicroFixVaultCipherKind::Aes256Gcm
+                                                            : MicroFixVaultCipherKind::ChaCha20Poly1305)) {
+        std::memcpy(chachaKey, key, kKeyBytes);
+        if (cipherKind == MicroFixVaultCipherKind::Aes256Gcm) {
+#ifdef MICROFIX_X86_SIMD
+            if (!hardwareAesAvailable()) throw std::runtime_error("AES-GCM requested without AES-NI/PCLMUL");
+            aesInit(key);
+#else
+            throw std::runtime_error("AES-GCM requested without AES-NI/PCLMUL");
+#endif
+        }
+    }
+
+    ~MicroFixVaultCipher() {
+        volatile uint8_t* wipe = chachaKey;
+        for (size_t i = 0; i < sizeof(chachaKey); ++i) wipe[i] = 0;
+        wipe = roundKeys;
+        for (size_t i = 0; i < sizeof(roundKeys); ++i) wipe[i] = 0;
+    }
+
+    MicroFixVaultCipher(const MicroFixVaultCipher&) = delete;
+    MicroFixVaultCipher& operator=(const MicroFixVaultCipher&) = delete;
+
+    MicroFixVaultCipherKind kind() const { return cipherKind; }
+
+    // out may alias in; len need not be a multiple of the block size
+    void seal(const uint8_t* nonce, const uint8_t* aad, size_t aadLen, const uint8_t* in, uint8_t* out, size_t len,
+              uint8_t* tag) const {
+#ifdef MICROFIX_X86_SIMD
+        if (cipherKind == MicroFixVaultCipherKind::Aes256Gcm) return gcmCrypt(nonce, aad, aadLen, in, out, len, tag, true);
+#endif
+        chachaSeal(nonce, aad, aadLen, in, out, len, tag);
+    }
+
+    // Returns false (and zeroes out) when the tag does not authenticate
+    bool open(const uint8_t* nonce, const uint8_t* aad, size_t aadLen, const uint8_t* in, uint8_t* out, size_t len,
+              const uint8_t* tag) const {
+        uint8_t expected[kTagBytes];
+#ifdef MICROFIX_X86_SIMD
+        if (cipherKind == MicroFixVaultCipherKind::Aes256Gcm) {
+            gcmCrypt(nonce, aad, aadLen, in, out, len, expected, false);
+        } else
+#endif
+        {
+            chachaOpen(nonce, aad, aadLen, in, out, len, expected);
+        }
+        uint8_t diff = 0;
+        for (size_t i = 0; i < kTagBytes; ++i) diff |= expected[i] ^ tag[i];
+        if (diff != 0) {
+            std::memset(out, 0, len);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    MicroFixVaultCipherKind cipherKind;
+    uint8_t chachaKey[kKeyBytes];
+    alignas(16) uint8_t roundKeys[15 * 16] = {};
+    alignas(16) uint8_t hashKeyPowers[8 * 16] = {};  // Byte-reflected H^1..H^8 for aggregated GHASH
+
+    // ---- ChaCha20-Poly1305 (portable) ----
+
+    static uint32_t load32(const uint8_t* p) { return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24; }
+    static uint64_t load64(const uint8_t* p) { return uint64_t(load32(p)) | uint64_t(load32(p + 4)) << 32; }
+
+    static void store64(uint8_t* p, uint64_t v) {
+        for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+
+    static uint32_t rotl(uint32_t v, int bits) { return (v << bits) | (v >> (32 - bits)); }
+
+    static void quarterRound(uint32_t* x, int a, int b, int c, int d) {
+        x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 16);
+        x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 12);
+        x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 8);
+        x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 7);
+    }
+
+    void chachaBlock(const uint8_t* nonce, uint32_t counter, uint8_t* out) const {
+        uint32_t state[16] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+        for (int i = 0; i < 8; ++i) state[4 + i] = load32(chachaKey + 4 * i);
+        state[12] = counter;
+        for (int i = 0; i < 3; ++i) state[13 + i] = load32(nonce + 4 * i);
+        uint32_t x[16];
+        std::memcpy(x, state, sizeof(x));
+        for (int round = 0; round < 10; ++round) {
+            quarterRound(x, 0, 4, 8, 12);
+            quarterRound(x, 1, 5, 9, 13);
+            quarterRound(x, 2, 6, 10, 14);
+            quarterRound(x, 3, 7, 11, 15);
+            quarterRound(x, 0, 5, 10, 15);
+            quarterRound(x, 1, 6, 11, 12);
+            quarterRound(x, 2, 7, 8, 13);
+            quarterRound(x, 3, 4, 9, 14);
+        }
+        for (int i = 0; i < 16; ++i) {
+            uint32_t word = x[i] + state[i];
+            out[4 * i] = static_cast<uint8_t>(word);
+            out[4 * i + 1] = static_cast<uint8_t>(word >> 8);
+            out[4 * i + 2] = static_cast<uint8_t>(word >> 16);
+            out[4 * i + 3] = static_cast<uint8_t>(word >> 24);
+        }
+    }
+
+    // Four blocks side by side, word-major, so the lane loops compile to plain SIMD on any target
+    void chachaBlocks4(const uint8_t* nonce, uint32_t counter, uint8_t* out) const {
+        uint32_t state[16][4];
+        const uint32_t constants[4] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+        for (int lane = 0; lane < 4; ++lane) {
+            for (int i = 0; i < 4; ++i) state[i][lane] = constants[i];
+            for (int i = 0; i < 8; ++i) state[4 + i][lane] = load32(chachaKey + 4 * i);
+            state[12][lane] = counter + lane;
+            for (int i = 0; i < 3; ++i) state[13 + i][lane] = load32(nonce + 4 * i);
+        }
+        uint32_t x[16][4];
+        std::memcpy(x, state, sizeof(x));
+        auto quarter = [&x](int a, int b, int c, int d) {
+            for (int lane = 0; lane < 4; ++lane) {
+                x[a][lane] += x[b][lane]; x[d][lane] = rotl(x[d][lane] ^ x[a][lane], 16);
+                x[c][lane] += x[d][lane]; x[b][lane] = rotl(x[b][lane] ^ x[c][lane], 12);
+                x[a][lane] += x[b][lane]; x[d][lane] = rotl(x[d][lane] ^ x[a][lane], 8);
+                x[c][lane] += x[d][lane]; x[b][lane] = rotl(x[b][lane] ^ x[c][lane], 7);
+            }
+        };
+        for (int round = 0; round < 10; ++round) {
+            quarter(0, 4, 8, 12);
+            quarter(1, 5, 9, 13);
+            quarter(2, 6, 10, 14);
+            quarter(3, 7, 11, 15);
+            quarter(0, 5, 10, 15);
+            quarter(1, 6, 11, 12);
+            quarter(2, 7, 8, 13);
+            quarter(3, 4, 9, 14);
+        }
+        for (int lane = 0; lane < 4; ++lane) {
+            for (int i = 0; i < 16; ++i) {
+                uint32_t word = x[i][lane] + state[i][lane];
+                uint8_t* p = out + 64 * lane + 4 * i;
+                p[0] = static_cast<uint8_t>(word);
+                p[1] = static_cast<uint8_t>(word >> 8);
+                p[2] = static_cast<uint8_t>(word >> 16);
+                p[3] = static_cast<uint8_t>(word >> 24);
+            }
+        }
+    }
+
+    void chachaXor(const uint8_t* nonce, uint32_t counter, const uint8_t* in, uint8_t* out, size_t len) const {
+        uint8_t stream[256];
+        size_t offset = 0;
+        for (; offset + 256 <= len; offset += 256, counter += 4) {
+            chachaBlocks4(nonce, counter, stream);
+            for (size_t i = 0; i < 256; ++i) out[offset + i] = in[offset + i] ^ stream[i];
+        }
+        for (; offset < len; offset += 64, ++counter) {
+            chachaBlock(nonce, counter, stream);
+            size_t n = len - offset < 64 ? len - offset : 64;
+            for (size_t i = 0; i < n; ++i) out[offset + i] = in[offset + i] ^ stream[i];
+        }
+    }
+
+    // poly1305-donna with 26-bit limbs: every product is 32x32->64, so no 128-bit type is
+    // needed and the same code builds on MSVC and 32-bit targets
+    class Poly1305 {
+    public:
+        explicit Poly1305(const uint8_t* key) {
+            r[0] = load32(key) & 0x3ffffff;
+            r[1] = (load32(key + 3) >> 2) & 0x3ffff03;
+            r[2] = (load32(key + 6) >> 4) & 0x3ffc0ff;
+            r[3] = (load32(key + 9) >> 6) & 0x3f03fff;
+            r[4] = (load32(key + 12) >> 8) & 0x00fffff;
+            for (int i = 0; i < 4; ++i) pad[i] = load32(key + 16 + 4 * i);
+        }
+
+        // Absorbs data zero-padded to a 16-byte boundary, as the AEAD construction does
+        void updatePadded(const uint8_t* data, size_t len) {
+            size_t full = len & ~size_t(15);
+            blocks(data, full);
+            if (len > full) {
+                uint8_t block[16] = {};
+                std::memcpy(block, data + full, len - full);
+                blocks(block, 16);
+            }
+        }
+
+        void finish(uint64_t aadLen, uint64_t textLen, uint8_t* tag) {
+            uint8_t lengths[16];
+            store64(lengths, aadLen);
+            store64(lengths + 8, textLen);
+            blocks(lengths, 16);
+
+            constexpr uint32_t m26 = 0x3ffffff;
+            uint32_t h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4], c;
+            c = h1 >> 26; h1 &= m26; h2 += c;
+            c = h2 >> 26; h2 &= m26; h3 += c;
+            c = h3 >> 26; h3 &= m26; h4 += c;
+            c = h4 >> 26; h4 &= m26; h0 += c * 5;
+            c = h0 >> 26; h0 &= m26; h1 += c;
+
+            uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= m26;
+            uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= m26;
+            uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= m26;
+            uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= m26;
+            uint32_t g4 = h4 + c - (uint32_t(1) << 26);
+            c = (g4 >> 31) - 1;  // All ones when h >= 2^130 - 5
+            h0 = (h0 & ~c) | (g0 & c);
+            h1 = (h1 & ~c) | (g1 & c);
+            h2 = (h2 & ~c) | (g2 & c);
+            h3 = (h3 & ~c) | (g3 & c);
+            h4 = (h4 & ~c) | (g4 & c);
+
+            // Repack into four 32-bit words and add the pad mod 2^128
+            uint32_t w0 = h0 | (h1 << 26), w1 = (h1 >> 6) | (h2 << 20), w2 = (h2 >> 12) | (h3 << 14), w3 = (h3 >> 18) | (h4 << 8);
+            uint64_t f = uint64_t(w0) + pad[0];
+            uint64_t lo = uint32_t(f);
+            f = uint64_t(w1) + pad[1] + (f >> 32);
+            lo |= f << 32;
+            f = uint64_t(w2) + pad[2] + (f >> 32);
+            uint64_t hi = uint32_t(f);
+            f = uint64_t(w3) + pad[3] + (f >> 32);
+            hi |= f << 32;
+            store64(tag, lo);
+            store64(tag + 8, hi);
+        }
+
+    private:
+        uint32_t r[5];
+        uint32_t h[5] = {0, 0, 0, 0, 0};
+        uint32_t pad[4];
+
+        void blocks(const uint8_t* m, size_t len) {
+            constexpr uint32_t m26 = 0x3ffffff;
+            uint32_t r0 = r[0], r1 = r[1], r2 = r[2], r3 = r[3], r4 = r[4];
+            uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+            uint32_t h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4];
+            for (; len >= 16; m += 16, len -= 16) {
+                h0 += load32(m) & m26;
+                h1 += (load32(m + 3) >> 2) & m26;
+                h2 += (load32(m + 6) >> 4) & m26;
+                h3 += (load32(m + 9) >> 6) & m26;
+                h4 += (load32(m + 12) >> 8) | (uint32_t(1) << 24);
+                uint64_t d0 = uint64_t(h0) * r0 + uint64_t(h1) * s4 + uint64_t(h2) * s3 + uint64_t(h3) * s2 + uint64_t(h4) * s1;
+                uint64_t d1 = uint64_t(h0) * r1 + uint64_t(h1) * r0 + uint64_t(h2) * s4 + uint64_t(h3) * s3 + uint64_t(h4) * s2;
+                uint64_t d2 = uint64_t(h0) * r2 + uint64_t(h1) * r1 + uint64_t(h2) * r0 + uint64_t(h3) * s4 + uint64_t(h4) * s3;
+                uint64_t d3 = uint64_t(h0) * r3 + uint64_t(h1) * r2 + uint64_t(h2) * r1 + uint64_t(h3) * r0 + uint64_t(h4) * s4;
+                uint64_t d4 = uint64_t(h0) * r4 + uint64_t(h1) * r3 + uint64_t(h2) * r2 + uint64_t(h3) * r1 + uint64_t(h4) * r0;
+                uint32_t c = uint32_t(d0 >> 26); h0 = uint32_t(d0) & m26;
+                d1 += c; c = uint32_t(d1 >> 26); h1 = uint32_t(d1) & m26;
+                d2 += c; c = uint32_t(d2 >> 26); h2 = uint32_t(d2) & m26;
+                d3 += c; c = uint32_t(d3 >> 26); h3 = uint32_t(d3) & m26;
+                d4 += c; c = uint32_t(d4 >> 26); h4 = uint32_t(d4) & m26;
+                h0 += c * 5; c = h0 >> 26; h0 &= m26;
+                h1 += c;
+            }
+            h[0] = h0; h[1] = h1; h[2] = h2; h[3] = h3; h[4] = h4;
+        }
+    };
+
+    void chachaSeal(const uint8_t* nonce, const uint8_t* aad, size_t aadLen, const uint8_t* in, uint8_t* out, size_t len,
+                    uint8_t* tag) const {
+        uint8_t polyKey[64];
+        chachaBlock(nonce, 0, polyKey);
+        chachaXor(nonce, 1, in, out, len);
+        Poly1305 mac(polyKey);
+        mac.updatePadded(aad, aadLen);
+        mac.updatePadded(out, len);
+        mac.finish(aadLen, len, tag);
+    }
+
+    void chachaOpen(const uint8_t* nonce, const uint8_t* aad, size_t aadLen, const uint8_t* in, uint8_t* out, size_t len,
+                    uint8_t* tag) const {
+        uint8_t polyKey[64];
+        chachaBlock(nonce, 0, polyKey);
+        Poly1305 mac(polyKey);
+        mac.updatePadded(aad, aadLen);
+        mac.updatePadded(in, len);
+        mac.finish(aadLen, len, tag);
+        chachaXor(nonce, 1, in, out, len);
+    }
+
+#ifdef MICROFIX_X86_SIMD
+    // ---- AES-256-GCM (AES-NI + PCLMULQDQ) ----
+
+    __attribute__((target("ssse3"))) static __m128i byteSwap(__m128i v) {
+        return _mm_shuffle_epi8(v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    }
+
+    template <int Rcon>
+    __attribute__((target("aes"))) static void expandRound(__m128i* rk, int i) {
+        __m128i assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[i - 1], Rcon), 0xff);
+        __m128i key = rk[i - 2];
+        key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+        key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+        key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+        rk[i] = _mm_xor_si128(key, assist);
+        if (i == 14) return;
+        assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[i], 0), 0xaa);
+        key = rk[i - 1];
+        key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+        key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+        key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+        rk[i + 1] = _mm_xor_si128(key, assist);
+    }
+
+    __attribute__((target("aes,pclmul,ssse3"))) void aesInit(const uint8_t* key) {
+        __m128i rk[15];
+        rk[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+        rk[1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + 16));
+        expandRound<0x01>(rk, 2);
+        expandRound<0x02>(rk, 4);
+        expandRound<0x04>(rk, 6);
+        expandRound<0x08>(rk, 8);
+        expandRound<0x10>(rk, 10);
+        expandRound<0x20>(rk, 12);
+        expandRound<0x40>(rk, 14);
+        for (int i = 0; i < 15; ++i) _mm_store_si128(reinterpret_cast<__m128i*>(roundKeys) + i, rk[i]);
+
+        __m128i hashKey = byteSwap(aesEncrypt(_mm_setzero_si128()));
+        __m128i power = hashKey;
+        for (int i = 0; i < 8; ++i) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(hashKeyPowers) + i, power);
+            power = gfMul(power, hashKey);
+        }
+    }
+
+    __attribute__((target("aes"))) __m128i aesEncrypt(__m128i block) const {
+        const __m128i* rk = reinterpret_cast<const __m128i*>(roundKeys);
+        block = _mm_xor_si128(block, _mm_load_si128(rk));
+        for (int i = 1; i < 14; ++i) block = _mm_aesenc_si128(block, _mm_load_si128(rk + i));
+        return _mm_aesenclast_si128(block, _mm_load_si128(rk + 14));
+    }
+
+    // Unreduced 256-bit carry-less product accumulated into (lo, hi)
+    __attribute__((target("pclmul"))) static void clMulAdd(__m128i a, __m128i b, __m128i& lo, __m128i& hi) {
+        __m128i low = _mm_clmulepi64_si128(a, b, 0x00);
+        __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+        __m128i high = _mm_clmulepi64_si128(a, b, 0x11);
+        lo = _mm_xor_si128(lo, _mm_xor_si128(low, _mm_slli_si128(mid, 8)));
+        hi = _mm_xor_si128(hi, _mm_xor_si128(high, _mm_srli_si128(mid, 8)));
+    }
+
+    // Shift the reflected product left by one, then reduce modulo x^128 + x^7 + x^2 + x + 1
+    static __m128i gfReduce(__m128i lo, __m128i hi) {
+        __m128i carryLo = _mm_srli_epi32(lo, 31);
+        __m128i carryHi = _mm_srli_epi32(hi, 31);
+        lo = _mm_slli_epi32(lo, 1);
+        hi = _mm_slli_epi32(hi, 1);
+        __m128i crossing = _mm_srli_si128(carryLo, 12);
+        hi = _mm_or_si128(hi, _mm_slli_si128(carryHi, 4));
+        lo = _mm_or_si128(lo, _mm_slli_si128(carryLo, 4));
+        hi = _mm_or_si128(hi, crossing);
+
+        __m128i fold = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+        __m128i foldHigh = _mm_srli_si128(fold, 4);
+        lo = _mm_xor_si128(lo, _mm_slli_si128(fold, 12));
+        __m128i back = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+        back = _mm_xor_si128(back, foldHigh);
+        return _mm_xor_si128(hi, _mm_xor_si128(lo, back));
+    }
+
+    __attribute__((target("pclmul"))) static __m128i gfMul(__m128i a, __m128i b) {
+        __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+        clMulAdd(a, b, lo, hi);
+        return gfReduce(lo, hi);
+    }
+
+    __m128i hashPower(int n) const { return _mm_load_si128(reinterpret_cast<const __m128i*>(hashKeyPowers) + (n - 1)); }
+
+    // Folds up to 8 whole blocks into the GHASH state with a single reduction
+    __attribute__((target("pclmul,ssse3"))) __m128i ghashBlocks(__m128i state, const uint8_t* data, size_t blocks) const {
+        while (blocks > 0) {
+            size_t n = blocks < 8 ? blocks : 8;
+            __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+            for (size_t i = 0; i < n; ++i) {
+                __m128i block = byteSwap(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + i));
+                if (i == 0) block = _mm_xor_si128(block, state);
+                clMulAdd(block, hashPower(static_cast<int>(n - i)), lo, hi);
+            }
+            state = gfReduce(lo, hi);
+            data += 16 * n;
+            blocks -= n;
+        }
+        return state;
+    }
+
+    // Fully unrolled form of ghashBlocks for the bulk loop
+    __attribute__((target("pclmul,ssse3"))) __m128i ghashEight(__m128i state, const uint8_t* data) const {
+        __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+        __m128i first = _mm_xor_si128(byteSwap(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), state);
+        clMulAdd(first, hashPower(8), lo, hi);
+#pragma GCC unroll 7
+        for (int i = 1; i < 8; ++i) {
+            clMulAdd(byteSwap(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + i)), hashPower(8 - i), lo, hi);
+        }
+        return gfReduce(lo, hi);
+    }
+
+    __attribute__((target("pclmul,ssse3"))) __m128i ghashPadded(__m128i state, const uint8_t* data, size_t len) const {
+        state = ghashBlocks(state, data, len / 16);
+        if (len % 16) {
+            uint8_t block[16] = {};
+            std::memcpy(block, data + len - len % 16, len % 16);
+            state = ghashBlocks(state, block, 1);
+        }
+        return state;
+    }
+
+    // One pass over the text: eight counter blocks in flight, and GHASH over the ciphertext
+    // side (output when sealing, input when opening) while it is still in cache
+    __attribute__((target("aes,pclmul,ssse3")))
+    void gcmCrypt(const uint8_t* nonce, const uint8_t* aad, size_t aadLen, const uint8_t* in, uint8_t* out, size_t len,
+                  uint8_t* tag, bool sealing) const {
+        const __m128i* rk = reinterpret_cast<const __m128i*>(roundKeys);
+        uint8_t counterBlock[16] = {};
+        std::memcpy(counterBlock, nonce, kNonceBytes);
+        counterBlock[15] = 1;
+        __m128i preCounter = _mm_loadu_si128(reinterpret_cast<const __m128i*>(counterBlock));
+        __m128i counter = byteSwap(preCounter);  // Lane 0 now holds the 32-bit block counter
+        const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+
+        __m128i hash = ghashPadded(_mm_setzero_si128(), aad, aadLen);
+
+        size_t offset = 0;
+        for (; offset + 128 <= len; offset += 128) {
+            const uint8_t* ciphertext = sealing ? out + offset : in + offset;
+            if (!sealing) hash = ghashEight(hash, ciphertext);
+            __m128i blocks[8];
+#pragma GCC unroll 8
+            for (int i = 0; i < 8; ++i) {
+                counter = _mm_add_epi32(counter, one);
+                blocks[i] = _mm_xor_si128(byteSwap(counter), _mm_load_si128(rk));
+            }
+            for (int round = 1; round < 14; ++round) {
+                __m128i key = _mm_load_si128(rk + round);
+#pragma GCC unroll 8
+                for (int i = 0; i < 8; ++i) blocks[i] = _mm_aesenc_si128(blocks[i], key);
+            }
+            __m128i last = _mm_load_si128(rk + 14);
+#pragma GCC unroll 8
+            for (int i = 0; i < 8; ++i) {
+                __m128i text = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset) + i);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset) + i,
+                                 _mm_xor_si128(text, _mm_aesenclast_si128(blocks[i], last)));
+            }
+            if (sealing) hash = ghashEight(hash, ciphertext);
+        }
+
+        size_t tail = len - offset;
+        if (tail > 0) {
+            if (!sealing) hash = ghashPadded(hash, in + offset, tail);
+            for (size_t pos = 0; pos < tail; pos += 16) {
+                counter = _mm_add_epi32(counter, one);
+                uint8_t stream[16];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(stream), aesEncrypt(byteSwap(counter)));
+                size_t n = tail - pos < 16 ? tail - pos : 16;
+                for (size_t i = 0; i < n; ++i) out[offset + pos + i] = in[offset + pos + i] ^ stream[i];
+            }
+            if (sealing) hash = ghashPadded(hash, out + offset, tail);
+        }
+
+        uint8_t lengths[16];
+        uint64_t aadBits = uint64_t(aadLen) * 8, textBits = uint64_t(len) * 8;
+        for (int i = 0; i < 8; ++i) {
+            lengths[i] = static_cast<uint8_t>(aadBits >> (56 - 8 * i));
+            lengths[8 + i] = static_cast<uint8_t>(textBits >> (56 - 8 * i));
+        }
+        hash = ghashBlocks(hash, lengths, 1);
+        __m128i mask = aesEncrypt(preCounter);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(tag), _mm_xor_si128(byteSwap(hash), mask));
+    }
+#endif
+};
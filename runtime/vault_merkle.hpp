@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "memory_vault.hpp"
+#include "sha256.hpp"
+#include "worker_pool.hpp"
+
+struct MicroFixMerkleReport {
+    bool intact = true;
+    std::vector<size_t> corruptPages;  // Pages whose sealed bytes no longer match their leaf
+};
+
+// Merkle tree over the sealed pages of a MicroFixEncryptedVault. A write only rehashes the
+// page's leaf and its ancestors, a single-page check is one leaf plus log2(pages) nodes,
+// and full verification hashes leaves and each tree level in parallel on the worker pool.
+// Leaves cover (index, generation, tag, ciphertext), so replaying an older sealed page fails.
+// Like the vault, the tree has one writer; verification must not overlap updates.
+class MicroFixVaultMerkle {
+public:
+    explicit MicroFixVaultMerkle(const MicroFixEncryptedVault& vault, MicroFixWorkerPool* pool = nullptr) : vault(vault) {
+        if (vault.pageCount() == 0) throw std::invalid_argument("Merkle tree needs at least one vault page");
+        for (size_t width = vault.pageCount();; width = (width + 1) / 2) {
+            levels.emplace_back(width);
+            if (width == 1) break;
+        }
+        rebuild(pool);
+    }
+
+    const MicroFixDigest& root() const { return levels.back()[0]; }
+
+    // Call after vault.write(page)
+    void update(size_t page) { updateRange(page, 1); }
+
+    // Call after vault.writeBatch(first, count): shared ancestors are hashed once
+    void updateRange(size_t first, size_t count) {
+        if (count == 0) return;
+        if (first + count > vault.pageCount()) throw std::out_of_range("Merkle update out of range");
+        for (size_t page = first; page < first + count; ++page) levels[0][page] = leafHash(page);
+        size_t lo = first, hi = first + count - 1;
+        for (size_t level = 1; level < levels.size(); ++level) {
+            lo /= 2;
+            hi /= 2;
+            for (size_t node = lo; node <= hi; ++node) levels[level][node] = parentHash(node, levels[level - 1]);
+        }
+    }
+
+    // Rehashes the page and folds it up the stored sibling path; true if that reproduces the root
+    bool verifyPage(size_t page) const {
+        if (page >= vault.pageCount()) throw std::out_of_range("Merkle page out of range");
+        MicroFixDigest digest = leafHash(page);
+        size_t index = page;
+        for (size_t level = 0; level + 1 < levels.size(); ++level, index /= 2) {
+            size_t sibling = index ^ 1;
+            if (sibling >= levels[level].size()) continue;  // Odd node is promoted unchanged
+            digest = index & 1 ? nodeHash(levels[level][sibling], digest) : nodeHash(digest, levels[level][sibling]);
+        }
+        return digest == root();
+    }
+
+    // Full verification: every leaf rehashed in parallel, then every level rebuilt from the fresh leaves
+    MicroFixMerkleReport verifyAll(MicroFixWorkerPool* pool = nullptr) const {
+        std::vector<std::vector<MicroFixDigest>> fresh;
+        for (const auto& level : levels) fresh.emplace_back(level.size());
+        hashLevels(fresh, pool);
+
+        MicroFixMerkleReport report;
+        for (size_t page = 0; page < fresh[0].size(); ++page) {
+            if (fresh[0][page] != levels[0][page]) report.corruptPages.push_back(page);
+        }
+        report.intact = report.corruptPages.empty() && fresh.back()[0] == root();
+        return report;
+    }
+
+    void rebuild(MicroFixWorkerPool* pool = nullptr) { hashLevels(levels, pool); }
+
+private:
+    static constexpr size_t kLeavesPerChunk = 16;
+    static constexpr size_t kNodesPerChunk = 1024;
+
+    const MicroFixEncryptedVault& vault;
+    std::vector<std::vector<MicroFixDigest>> levels;  // levels[0] = leaves, levels.back() = { root }
+
+    MicroFixDigest leafHash(size_t page) const {
+        uint8_t header[17] = {0x00};  // Domain-separates leaves from interior nodes
+        uint64_t index = page, generation = vault.generation(page);
+        std::memcpy(header + 1, &index, sizeof(index));
+        std::memcpy(header + 9, &generation, sizeof(generation));
+        MicroFixSha256 sha;
+        sha.update(header, sizeof(header));
+        sha.update(vault.pageTag(page), MicroFixVaultCipher::kTagBytes);
+        sha.update(vault.sealedPage(page), vault.pageBytes());
+        return sha.finish();
+    }
+
+    static MicroFixDigest nodeHash(const MicroFixDigest& left, const MicroFixDigest& right) {
+        uint8_t block[65] = {0x01};
+        std::memcpy(block + 1, left.data(), left.size());
+        std::memcpy(block + 33, right.data(), right.size());
+        return MicroFixSha256::hash(block, sizeof(block));
+    }
+
+    static MicroFixDigest parentHash(size_t node, const std::vector<MicroFixDigest>& children) {
+        size_t left = node * 2;
+        return left + 1 < children.size() ? nodeHash(children[left], children[left + 1]) : children[left];
+    }
+
+    void hashLevels(std::vector<std::vector<MicroFixDigest>>& out, MicroFixWorkerPool* pool) const {
+        parallelChunks(out[0].size(), kLeavesPerChunk, pool, [&](size_t page) { out[0][page] = leafHash(page); });
+        for (size_t level = 1; level < out.size(); ++level) {
+            parallelChunks(out[level].size(), kNodesPerChunk, pool,
+                           [&](size_t node) { out[level][node] = parentHash(node, out[level - 1]); });
+        }
+    }
+
+    template <class Fn>
+    static void parallelChunks(size_t items, size_t perChunk, MicroFixWorkerPool* pool, Fn&& fn) {
+        size_t chunks = (items + perChunk - 1) / perChunk;
+        auto runChunk = [&](size_t chunk, size_t) {
+            size_t end = std::min(items, (chunk + 1) * perChunk);
+            for (size_t i = chunk * perChunk; i < end; ++i) fn(i);
+        };
+        if (!pool || chunks <= 1) {
+            for (size_t chunk = 0; chunk < chunks; ++chunk) runChunk(chunk, 0);
+            return;
+        }
+        pool->parallelFor(chunks, runChunk);
+    }
+};
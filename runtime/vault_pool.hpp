@@ -0,0 +1,422 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <new>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+struct MicroFixPoolClassStats {
+    size_t objectBytes = 0;   // Size class; 0 for the large (direct-mapped) class
+    uint64_t live = 0;
+    uint64_t peakLive = 0;
+    uint64_t capacity = 0;    // Slots carved from slabs so far
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+
+    double occupancy() const { return capacity ? double(live) / capacity : 0.0; }
+};
+
+struct MicroFixAllocationSite {
+    std::string file;
+    std::string function;
+    uint32_t line = 0;
+    uint64_t samples = 0;
+    uint64_t estimatedBytes = 0;  // Sampled bytes scaled by the sampling rate
+};
+
+// Size-class pool for vault records. Small objects come from per-class free lists carved
+// out of 64 KiB slabs, with no malloc header. Each thread keeps a small cache per class, so
+// the usual allocate/deallocate is a thread-local list pop/push; caches trade batches
+// with the shared tagged-pointer lists and publish counters every kPublishEvery calls.
+// With guard pages on, every object instead gets its own mapping that ends at a
+// PROT_NONE page, so an overrun faults right past the object. One in sampleEvery
+// allocations records its call site. Slabs go back to the OS when the pool is destroyed.
+// Off Linux, slabs and large objects come from page-aligned operator new and guard pages
+// are unavailable.
+class MicroFixVaultPool {
+public:
+    static constexpr std::array<size_t, 14> kClasses = {16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 2048, 4096};
+    static constexpr size_t kLargeClass = kClasses.size();
+    static constexpr size_t kSlabBytes = 64 * 1024;
+    static constexpr uint32_t kCacheSlots = 64;     // Per thread, per class
+    static constexpr uint32_t kPublishEvery = 256;  // Calls between counter publications
+
+    explicit MicroFixVaultPool(bool guardPages = false, uint32_t sampleEvery = 64)
+        : guardPages(guardPages), sampleEvery(sampleEvery), pageBytes(systemPageBytes()) {
+#ifndef __linux__
+        if (guardPages) throw std::runtime_error("Vault pool guard pages need mmap/mprotect");
+#endif
+        std::lock_guard<std::mutex> lock(registryLock());
+        id = ++registryIds();
+        registry()[id] = this;
+    }
+
+    ~MicroFixVaultPool() {
+        {
+            std::lock_guard<std::mutex> lock(registryLock());  // Thread caches check this before draining into us
+            registry().erase(id);
+        }
+        for (auto& sizeClass : classes) {
+            for (void* slab : sizeClass.slabs) unmapOrFree(slab, kSlabBytes);
+        }
+    }
+
+    MicroFixVaultPool(const MicroFixVaultPool&) = delete;
+    MicroFixVaultPool& operator=(const MicroFixVaultPool&) = delete;
+
+    // 16-byte aligned; release with deallocate(ptr, bytes) using the same size
+    void* allocate(size_t bytes, std::source_location site = std::source_location::current()) {
+        if (bytes == 0) bytes = 1;
+        size_t index = classIndex(bytes);
+        ThreadCache& cache = cacheFor();
+        if (sampleEvery && --cache.sampleCountdown == 0) recordSample(cache, bytes, site);
+        ++cache.allocations[index];
+        if (++cache.unpublished == kPublishEvery) publish(cache);
+
+        if (guardPages || index == kLargeClass) return allocateMapped(index, bytes);
+        if (!cache.heads[index]) refillCache(cache, index);
+        FreeSlot* slot = cache.heads[index];
+        cache.heads[index] = slot->next.load(std::memory_order_relaxed);
+        --cache.counts[index];
+        return slot;
+    }
+
+    void deallocate(void* ptr, size_t bytes) {
+        if (!ptr) return;
+        if (bytes == 0) bytes = 1;
+        size_t index = classIndex(bytes);
+        ThreadCache& cache = cacheFor();
+        ++cache.frees[index];
+        if (++cache.unpublished == kPublishEvery) publish(cache);
+
+        if (guardPages || index == kLargeClass) return deallocateMapped(index, ptr, bytes);
+        FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+        slot->next.store(cache.heads[index], std::memory_order_relaxed);
+        cache.heads[index] = slot;
+        if (++cache.counts[index] > kCacheSlots) spillCache(cache, index, kCacheSlots / 2);
+    }
+
+    // Returns the calling thread's cached slots and publishes its counters (threads also do this on exit)
+    void flushThreadCache() {
+        ThreadCache& cache = threadCache();
+        if (cache.poolId == id) cache.release();
+    }
+
+    bool guarded() const { return guardPages; }
+
+    // One entry per size class plus the large class last. Counters are published in batches,
+    // so they can trail each thread's most recent calls until flushThreadCache().
+    std::vector<MicroFixPoolClassStats> statistics() const {
+        std::vector<MicroFixPoolClassStats> out;
+        for (size_t index = 0; index < classes.size(); ++index) {
+            const SizeClass& sizeClass = classes[index];
+            MicroFixPoolClassStats stats;
+            stats.objectBytes = index < kClasses.size() ? kClasses[index] : 0;
+            stats.frees = sizeClass.frees.load(std::memory_order_relaxed);
+            stats.allocations = sizeClass.allocations.load(std::memory_order_relaxed);
+            stats.live = stats.allocations > stats.frees ? stats.allocations - stats.frees : 0;
+            stats.peakLive = std::max(sizeClass.peakLive.load(std::memory_order_relaxed), stats.live);
+            stats.capacity = sizeClass.capacity.load(std::memory_order_relaxed);
+            out.push_back(stats);
+        }
+        return out;
+    }
+
+    // Heaviest sites first
+    std::vector<MicroFixAllocationSite> sampledSites() {
+        std::lock_guard<std::mutex> lock(sitesLock);
+        std::vector<MicroFixAllocationSite> out;
+        for (const auto& [key, site] : sites) out.push_back(site);
+        std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) { return a.estimatedBytes > b.estimatedBytes; });
+        return out;
+    }
+
+private:
+    static_assert(sizeof(void*) <= 8, "Tagged free-list heads pack a 48-bit pointer and a 16-bit tag");
+    static constexpr uint64_t kPointerMask = (uint64_t(1) << 48) - 1;
+
+    // next is atomic because popSlot may read it from a slot another thread just popped
+    struct FreeSlot {
+        std::atomic<FreeSlot*> next;
+    };
+
+    struct alignas(64) SizeClass {
+        std::atomic<uint64_t> freeHead{0};   // Tagged pointer: the tag defeats ABA on concurrent pops
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+        std::atomic<uint64_t> peakLive{0};
+        std::atomic<uint64_t> capacity{0};
+        std::mutex refillLock;
+        std::vector<void*> slabs;
+    };
+
+    // Bound to one pool at a time; switching pools drains the cache back to its previous pool
+    struct ThreadCache {
+        uint64_t poolId = 0;
+        MicroFixVaultPool* pool = nullptr;
+        std::array<FreeSlot*, kClasses.size()> heads{};
+        std::array<uint32_t, kClasses.size()> counts{};
+        std::array<uint64_t, kClasses.size() + 1> allocations{};  // Not yet published
+        std::array<uint64_t, kClasses.size() + 1> frees{};
+        uint32_t unpublished = 0;
+        uint32_t sampleCountdown = 0;
+
+        ~ThreadCache() { release(); }
+
+        void release() {
+            if (pool) {
+                std::lock_guard<std::mutex> lock(registryLock());
+                auto it = registry().find(poolId);
+                if (it != registry().end() && it->second == pool) pool->drain(*this);  // A dead pool's slots are already unmapped
+            }
+            reset();
+        }
+
+        // In place: assigning a fresh ThreadCache would run the temporary's destructor, and with it release()
+        void reset() {
+            poolId = 0;
+            pool = nullptr;
+            heads.fill(nullptr);
+            counts.fill(0);
+            allocations.fill(0);
+            frees.fill(0);
+            unpublished = 0;
+            sampleCountdown = 0;
+        }
+    };
+
+    uint64_t id;
+    bool guardPages;
+    uint32_t sampleEvery;
+    size_t pageBytes;
+    std::array<SizeClass, kClasses.size() + 1> classes;
+    std::mutex sitesLock;
+    std::map<std::tuple<const char*, uint32_t, const char*>, MicroFixAllocationSite> sites;
+
+    static std::mutex& registryLock() {
+        static std::mutex lock;
+        return lock;
+    }
+
+    static std::map<uint64_t, MicroFixVaultPool*>& registry() {
+        static std::map<uint64_t, MicroFixVaultPool*> pools;
+        return pools;
+    }
+
+    static uint64_t& registryIds() {
+        static uint64_t ids = 0;
+        return ids;
+    }
+
+    static ThreadCache& threadCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    // The hot path stays small enough to inline; everything rare lives in its own member
+    ThreadCache& cacheFor() {
+        ThreadCache& cache = threadCache();
+        if (cache.poolId != id) bindCache(cache);
+        return cache;
+    }
+
+    void bindCache(ThreadCache& cache) {
+        cache.release();
+        cache.poolId = id;
+        cache.pool = this;
+        cache.sampleCountdown = sampleEvery;
+    }
+
+    // Class for each 16-byte step up to the largest class, so classIndex is one load
+    static constexpr auto kClassLookup = [] {
+        std::array<uint8_t, kClasses.back() / 16 + 1> table{};
+        size_t index = 0;
+        for (size_t step = 0; step < table.size(); ++step) {
+            while (kClasses[index] < step * 16) ++index;
+            table[step] = static_cast<uint8_t>(index);
+        }
+        return table;
+    }();
+
+    static size_t classIndex(size_t bytes) {
+        return bytes <= kClasses.back() ? kClassLookup[(bytes + 15) / 16] : kLargeClass;
+    }
+
+    static FreeSlot* slotOf(uint64_t head) { return reinterpret_cast<FreeSlot*>(static_cast<uintptr_t>(head & kPointerMask)); }
+    static uint64_t retag(uint64_t head, FreeSlot* slot) {
+        return ((head >> 48) + 1) << 48 | uint64_t(reinterpret_cast<uintptr_t>(slot));
+    }
+
+    static size_t systemPageBytes() {
+#ifdef __linux__
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 4096;
+#endif
+    }
+
+    // Page-aligned, and below 2^48 so slot addresses fit the tagged heads
+    void* mapOrThrow(size_t bytes) const {
+#ifdef __linux__
+        void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) throw std::bad_alloc();
+#else
+        void* mapped = ::operator new(bytes, std::align_val_t(pageBytes));
+#endif
+        if (uint64_t(reinterpret_cast<uintptr_t>(mapped)) & ~kPointerMask) {
+            unmapOrFree(mapped, bytes);
+            throw std::bad_alloc();
+        }
+        return mapped;
+    }
+
+    void unmapOrFree(void* base, size_t bytes) const {
+#ifdef __linux__
+        munmap(base, bytes);
+#else
+        ::operator delete(base, bytes, std::align_val_t(pageBytes));
+#endif
+    }
+
+    void publish(ThreadCache& cache) {
+        for (size_t index = 0; index < classes.size(); ++index) {
+            if (!cache.allocations[index] && !cache.frees[index]) continue;
+            SizeClass& sizeClass = classes[index];
+            uint64_t allocated = sizeClass.allocations.fetch_add(cache.allocations[index], std::memory_order_relaxed) + cache.allocations[index];
+            uint64_t freed = sizeClass.frees.fetch_add(cache.frees[index], std::memory_order_relaxed) + cache.frees[index];
+            uint64_t live = allocated > freed ? allocated - freed : 0;
+            uint64_t peak = sizeClass.peakLive.load(std::memory_order_relaxed);
+            while (live > peak && !sizeClass.peakLive.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+            cache.allocations[index] = cache.frees[index] = 0;
+        }
+        cache.unpublished = 0;
+    }
+
+    void drain(ThreadCache& cache) {
+        publish(cache);
+        for (size_t index = 0; index < kClasses.size(); ++index) {
+            if (cache.counts[index]) spillCache(cache, index, cache.counts[index]);
+        }
+    }
+
+    // Moves count slots from the top of the thread's list to the shared list in one CAS
+    void spillCache(ThreadCache& cache, size_t index, uint32_t count) {
+        FreeSlot* first = cache.heads[index];
+        FreeSlot* last = first;
+        for (uint32_t i = 1; i < count; ++i) last = last->next.load(std::memory_order_relaxed);
+        cache.heads[index] = last->next.load(std::memory_order_relaxed);
+        cache.counts[index] -= count;
+        pushSlots(classes[index], first, last);
+    }
+
+    void refillCache(ThreadCache& cache, size_t index) {
+        for (uint32_t i = 0; i < kCacheSlots / 2; ++i) {
+            FreeSlot* slot = popSlot(classes[index], index);
+            slot->next.store(cache.heads[index], std::memory_order_relaxed);
+            cache.heads[index] = slot;
+            ++cache.counts[index];
+        }
+    }
+
+    void pushSlots(SizeClass& sizeClass, FreeSlot* first, FreeSlot* last) {
+        uint64_t head = sizeClass.freeHead.load(std::memory_order_relaxed);
+        do {
+            last->next.store(slotOf(head), std::memory_order_relaxed);
+        } while (!sizeClass.freeHead.compare_exchange_weak(head, retag(head, first), std::memory_order_release,
+                                                           std::memory_order_relaxed));
+    }
+
+    FreeSlot* popSlot(SizeClass& sizeClass, size_t index) {
+        for (;;) {
+            uint64_t head = sizeClass.freeHead.load(std::memory_order_acquire);
+            while (FreeSlot* slot = slotOf(head)) {
+                // Slab memory stays mapped and next is atomic, so reading next of a slot another
+                // thread just took is defined; the tag changed in that case and the CAS retries
+                FreeSlot* next = slot->next.load(std::memory_order_relaxed);
+                if (sizeClass.freeHead.compare_exchange_weak(head, retag(head, next), std::memory_order_acquire,
+                                                             std::memory_order_acquire)) {
+                    return slot;
+                }
+            }
+            refillShared(sizeClass, index);
+        }
+    }
+
+    // Carves a fresh slab into a chain, lowest address first, and splices it onto the shared list
+    void refillShared(SizeClass& sizeClass, size_t index) {
+        std::lock_guard<std::mutex> lock(sizeClass.refillLock);
+        if (slotOf(sizeClass.freeHead.load(std::memory_order_acquire))) return;  // Another thread refilled
+        char* slab = static_cast<char*>(mapOrThrow(kSlabBytes));
+        sizeClass.slabs.push_back(slab);
+        size_t slotBytes = kClasses[index];
+        size_t slots = kSlabBytes / slotBytes;
+        for (size_t i = 0; i + 1 < slots; ++i) {
+            reinterpret_cast<FreeSlot*>(slab + i * slotBytes)->next.store(reinterpret_cast<FreeSlot*>(slab + (i + 1) * slotBytes),
+                                                                          std::memory_order_relaxed);
+        }
+        sizeClass.capacity.fetch_add(slots, std::memory_order_relaxed);
+        pushSlots(sizeClass, reinterpret_cast<FreeSlot*>(slab), reinterpret_cast<FreeSlot*>(slab + (slots - 1) * slotBytes));
+    }
+
+    size_t guardedSpan(size_t bytes) const { return (bytes + pageBytes - 1) / pageBytes * pageBytes + (guardPages ? pageBytes : 0); }
+
+    // Object sits flush against the guard page (rounded down to 16-byte alignment)
+    void* mapGuarded(size_t bytes) {
+        size_t span = guardedSpan(bytes);
+        char* base = static_cast<char*>(mapOrThrow(span));
+        if (!guardPages) return base;
+#ifdef __linux__
+        char* guard = base + span - pageBytes;
+        if (mprotect(guard, pageBytes, PROT_NONE) != 0) {
+            munmap(base, span);
+            throw std::bad_alloc();
+        }
+        return reinterpret_cast<char*>(reinterpret_cast<uintptr_t>(guard - bytes) & ~uintptr_t(15));
+#else
+        return base;  // Unreachable: the constructor rejects guard pages off Linux
+#endif
+    }
+
+    void* allocateMapped(size_t index, size_t bytes) {
+        classes[index].capacity.fetch_add(1, std::memory_order_relaxed);  // Direct mappings are their own capacity
+        return mapGuarded(bytes);
+    }
+
+    void deallocateMapped(size_t index, void* ptr, size_t bytes) {
+        unmapGuarded(ptr, bytes);
+        classes[index].capacity.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void unmapGuarded(void* ptr, size_t bytes) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t(pageBytes) - 1);
+        unmapOrFree(reinterpret_cast<void*>(base), guardedSpan(bytes));
+    }
+
+    void recordSample(ThreadCache& cache, size_t bytes, const std::source_location& site) {
+        cache.sampleCountdown = sampleEvery;
+        std::lock_guard<std::mutex> lock(sitesLock);
+        auto key = std::make_tuple(site.file_name(), site.line(), site.function_name());
+        auto [it, inserted] = sites.try_emplace(key);
+        if (inserted) {
+            it->second.file = site.file_name();
+            it->second.function = site.function_name();
+            it->second.line = site.line();
+        }
+        it->second.samples += 1;
+        it->second.estimatedBytes += uint64_t(bytes) * sampleEvery;
+    }
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed worker pool shared by the runtime's parallel directive passes
+class MicroFixWorkerPool {
+public:
+    explicit MicroFixWorkerPool(size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this, i] {
+                currentWorker() = {this, i + 1};
+                workerLoop();
+            });
+        }
+    }
+
+    ~MicroFixWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(queueLock);
+            stopping = true;
+        }
+        queueReady.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    MicroFixWorkerPool(const MicroFixWorkerPool&) = delete;
+    MicroFixWorkerPool& operator=(const MicroFixWorkerPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    // Number of distinct slots parallelFor may hand out: every worker plus one caller
+    size_t slotCount() const { return workers.size() + 1; }
+
+    // Slot of the calling thread in this pool: 1..size() for its workers, 0 for any other
+    // thread, including workers of another pool
+    size_t currentSlot() const {
+        const WorkerSlot& worker = currentWorker();
+        return worker.pool == this ? worker.slot : 0;
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(queueLock);
+            tasks.push_back(std::move(task));
+        }
+        queueReady.notify_one();
+    }
+
+    // Runs body(chunk, slot) for chunk in [0, chunks). Chunks are claimed in increasing
+    // order per thread, and the caller works alongside the pool until all are done.
+    // If body throws, the remaining chunks are skipped and the first exception is
+    // rethrown on the caller once no thread can still be inside body.
+    void parallelFor(size_t chunks, const std::function<void(size_t, size_t)>& body) {
+        if (chunks == 0) return;
+        struct Shared {
+            std::atomic<size_t> next{0};
+            std::atomic<size_t> done{0};
+            std::atomic<bool> failed{false};
+            std::exception_ptr failure;  // Written once, by whoever sets failed
+            std::mutex doneLock;
+            std::condition_variable allDone;
+        };
+        auto shared = std::make_shared<Shared>();
+        size_t total = chunks;
+        auto run = [this, shared, total, &body] {
+            size_t slot = currentSlot();
+            size_t chunk;
+            // Helpers that start after the last chunk was claimed never touch body
+            while ((chunk = shared->next.fetch_add(1, std::memory_order_relaxed)) < total) {
+                if (!shared->failed.load(std::memory_order_acquire)) {
+                    try {
+                        body(chunk, slot);
+                    } catch (...) {
+                        bool expected = false;
+                        if (shared->failed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                            shared->failure = std::current_exception();
+                        }
+                    }
+                }
+                if (shared->done.fetch_add(1, std::memory_order_acq_rel) + 1 == total) {
+                    std::lock_guard<std::mutex> lock(shared->doneLock);
+                    shared->allDone.notify_all();
+                }
+            }
+        };
+        size_t helpers = std::min(workers.size(), chunks - 1);
+        for (size_t i = 0; i < helpers; ++i) submit(run);
+        run();
+        std::unique_lock<std::mutex> lock(shared->doneLock);
+        shared->allDone.wait(lock, [&] { return shared->done.load(std::memory_order_acquire) == total; });
+        if (shared->failure) std::rethrow_exception(shared->failure);
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex queueLock;
+    std::condition_variable queueReady;
+    bool stopping = false;
+
+    struct WorkerSlot {
+        const MicroFixWorkerPool* pool = nullptr;
+        size_t slot = 0;
+    };
+
+    static WorkerSlot& currentWorker() {
+        thread_local WorkerSlot worker;
+        return worker;
+    }
+
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(queueLock);
+                queueReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+};